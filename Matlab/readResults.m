@@ -0,0 +1,60 @@
+function r=readResults(filename)
+%r=readResults('sweep_topologies.vdcr') loads a binary result file of ResultSink (resultsink.h)
+%into a struct with one field per column, one row per run:
+%  r.topology, r.label: cell arrays of strings, r.algorithm: char column
+%  r.success_rate, r.total_p99, ...: column vectors
+%  r.total_hist, ...: one row of bucket counts per run, bucket b (from 1) holds the
+%  latencies up to 2^(floor((b-2)/8)-6)*(1+(mod(b-2,8)+1)/8) us, bucket 1 those below 1/64 us
+%e.g. r=readResults('sweep_topologies.vdcr'); sel=strcmp(r.topology,'FatTree_H4')&r.algorithm=='P';
+%the CSV files of ResultSink have the same columns without the histograms, for other tools
+fid=fopen(filename,'r','l');
+if fid<0
+	error('Cannot open %s for input',filename);
+end
+magic=fread(fid,4,'*char')';
+version=fread(fid,1,'uint32');
+if ~strcmp(magic,'VDCR')||version~=1
+	fclose(fid);
+	error('%s is not a result file of version 1',filename);
+end
+nColumn=fread(fid,1,'int32');
+name=cell(nColumn,1);type=char(zeros(nColumn,1));width=zeros(nColumn,1);
+for c=1:nColumn
+	s=fread(fid,24,'*char')';
+	name{c}=s(1:find([s char(0)]==0,1)-1);
+	type(c)=fread(fid,1,'*char');
+	fread(fid,3,'uint8');
+	width(c)=fread(fid,1,'int32');
+end
+%the blocks: n rows, then the columns one after the other
+blocks=cell(nColumn,0);
+while true
+	n=fread(fid,1,'int32');
+	if isempty(n)
+		break;
+	end
+	b=cell(nColumn,1);
+	for c=1:nColumn
+		switch type(c)
+			case 'c'
+				b{c}=fread(fid,[width(c) n],'*char')';
+			case 'i'
+				b{c}=fread(fid,[width(c) n],'int32')';
+			otherwise
+				b{c}=fread(fid,[width(c) n],'single')';
+		end
+	end
+	blocks(:,end+1)=b;
+end
+fclose(fid);
+r=struct();
+for c=1:nColumn
+	x=vertcat(blocks{c,:});
+	if type(c)=='c'&&width(c)>1
+		x(x==0)=' ';
+		x=cellstr(x);
+	elseif type(c)=='c'
+		x(x==0)=' ';
+	end
+	r.(name{c})=x;
+end
@@ -0,0 +1,31 @@
+clear all;
+close all;
+%scaling curves of bench/build/scale.txt (make scale in bench): time per request against nServer
+fid=fopen('../bench/build/scale.txt');
+c=textscan(fid,'%s %f %s %s %f');
+fclose(fid);
+config=c{1};nServer=c{2};scenario=c{3};metric=c{4};value=c{5};
+family=strtok(config,'_');
+families=unique(family);
+scenarios={'static_P';'dynamic_P';'dynamic_F'};
+for i=1:length(families)
+	figure;
+	h=[];
+	for k=1:length(scenarios)
+		sel=strcmp(family,families{i})&strcmp(scenario,scenarios{k})&strcmp(metric,'latency_mean');
+		[n,order]=sort(nServer(sel));
+		t=value(sel);
+		h(k)=loglog(n,t(order));
+		hold on;
+	end
+	%n^2 through the first point of the last scenario: the quadratic terms
+	if ~isempty(n)
+		h(end+1)=loglog(n,t(order(1))*(n/n(1)).^2,'k--');
+	end
+	title(families{i});
+	xlabel('Number of servers');
+	ylabel('Time per request/us');
+	legend(h,[scenarios;{'n^2'}]);
+	set(h(1:length(scenarios)),{'Color'},{'r';'b';'g';});
+	set(h(1:length(scenarios)),{'Marker'},{'*';'O';'s';});
+end
@@ -12,6 +12,15 @@
 #include <functional>      // For greater<int>( )
 #include "binaryheaps.h"
 #include "elements.h"
+#include "bitsets.h"
+#include "events.h"
+#include "trace.h"
+#include "reqlog.h"
+#include "steady.h"
+#include "checkpoint.h"
+#include "timer.h"
+#include "latency.h"
+#include "counters.h"
 #include "parameter.h"
 #include "matrix.h"
 using namespace std;
@@ -24,33 +33,70 @@ private:
 	tNode Table[Nv];//store the index of its Adj
 	//int ARs[maxN][maxSlot][maxSlot][nServer];
 	//int ARx[maxN][maxN][maxN][Nv-nServer];
-	allocateRange AR[Nv];
+	allocateRange AR;	//allocation ranges AR(v,x,y,n) of all the nodes
 	Matrix<int> split;
+	// tree structure precomputed in drawTree
+	int childStart[Nv+1];	// children of v: childList[childStart[v]],...,childList[childStart[v+1]-1]
+	int childList[Nv];
+	int levelOrder[Nv];		// bottom-up order: the children before their parents
+	bool exclude[Nv];		// workspace of AddBasic and subFind
+	int pre[Nv],post[Nv];	// server j is in the subtree of v iff pre[v]<=pre[j]<post[v]
+	// hose loads of the current VDC, kept up to date by updateLoad
+	float subBw[Nv];		// total hostBw of the servers in the subtree of v
+	float minLimit[Nv];		// min total VDC bandwidth that congests an edge in the subtree of v
+	int minEdge[Nv];		// the edge reaching minLimit[v]
+	int congestedEdge;		// the congested edge found by the last CongestDetect
 public:
 	
 	float resBandwidth[Ne];
 	float Bandwidth[Ne];	
-	bool cut[Ne][nServer];
 
 	Tree();
 	~Tree();
 	void drawTree();
 	void AddEdge(const int & s, const int & d, const float &cost,const float &bandw,const int&addr);
 	void ClearNetwork();
-	void RandomNetwork(float p,float p_minResBw,float p_maxResBw);
+	Random rng;		// random stream of the runs
+	int stream;		// -1: every run starts from seed 0, else from stream "stream" of seed 0
+	void seedRun(){if(stream<0) rng.seed(0); else rng.seed(0,stream);}
+	RequestLog* requestLog;	// per-request records of ProcessRequest, none if 0
+	SteadyState* steadyState;	// steady state estimates and early stop of ProcessRequest, numOfreq is the limit
+	Checkpoint* checkpoint;		// snapshots and resume of ProcessRequest, none if 0
+	PhaseProfile* profile;		// latency histograms of the embedding phases, none if 0
+	// residual slots and bandwidths, for the checkpoints
+	template <class Archive> void saveNetwork(Archive& ar) const
+	{	for (int i=0;i<nServer;i++)
+			ar.put(Table[i].Slot);
+		ar.put(resBandwidth,Ne);
+	}
+	template <class Archive> void loadNetwork(Archive& ar)
+	{	for (int i=0;i<nServer;i++)
+			ar.get(Table[i].Slot);
+		ar.get(resBandwidth,Ne);
+	}
+	int n_trial;		// congestion checks of the current request
+	void RandomNetwork(Random& rng,float p,float p_minResBw,float p_maxResBw);
 
 	void reserveResource(const Solution &map);
 	void releaseResource(const Solution &map);
+	void reserveResource(const SparseSolution &vdc);
+	void releaseResource(const SparseSolution &vdc);
 	float ProcessRequest(char algorithm,int numOfreq,float load,
 						float &max_utilization,float &success_rate,float &bandwidth_cost,float &RC);
+	float ProcessRequest(char algorithm,RequestSource& source,int numOfreq,
+						float &max_utilization,float &success_rate,float &bandwidth_cost,float &RC);
 	float SingleRequest(char algorithm,int numOfreq,
 		float prob,float p_minResBw,float p_maxResBw,int  numOfVM,float minBw,float maxBw,
 		float &max_utilization,float &success_rate,float &bandwidth_cost);
 
 	int findBottleneck(float* hostBw,const Solution &map);
 	int findBottleneck(float *hostBw,float *TS,float *TD);
-	void updateBottlenecks(float *hostBw,const Solution&map,float *TS,float *TD);
+	void updateBottlenecks(float *hostBw,int the_link,float *TS,float *TD);
 
+	bool inSubtree(int j,int v) const {return pre[v]<=pre[j]&&pre[j]<post[v];}
+	void clearLoad();
+	void updateLoad(int s,float bw);
+	void fillBandwidth(Solution& map);
 	bool CongestDetect(int s,Cluster& req,float* hostBw,float sumB,Solution& map);
 	bool QuickFail(const Cluster& req,float& sumB,float* res_port_B);
 	// the embedding algorithm
@@ -59,13 +105,14 @@ public:
 	bool NextFit(Cluster &req,Solution &map);
 	bool BestFit(Cluster &req,Solution &map);
 	bool BackTracking(Cluster &req,Solution &map);
-	bool recursivePlacement(Cluster &req, Solution &map,vector<int>& assignment,float sumB,float* res_port_B,
+	bool recursivePlacement(Cluster &req, Solution &map,vector<int>& assignment,CandidateServers& cand,float sumB,float* res_port_B,
 						float* hostBw,int &numVMembedded);
 	int AddBasic(int x,int y, int v,int v_exclude);
 	void calculateAR(Cluster &req,float& sumB, int x, int y, int v);
 	bool subFind(Cluster &req,int x, int y, int v,int v_exclude,Matrix<bool> &Q,Solution &map);
 	bool subAssign(Cluster &req,int x, int y, int v,Matrix<bool> &Q,Solution &map);
 	bool GreedyARAllocation(Cluster &req,Solution &map);
+	void allocateAR(int numOfVM);	// the AR and split tables of GreedyARAllocation for requests up to numOfVM VMs
 	int getSplit(Cluster &req,float& sumB, int x, int y);
 };
 
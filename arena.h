@@ -0,0 +1,148 @@
+#ifndef arena_H
+#define arena_H
+#include <vector>
+#include <cstddef>
+#include <new>
+using namespace std;
+///////////////////////////////
+// bump allocator of the containers of a request: an allocation moves a pointer forward, a
+// deallocation does nothing, and the memory is given back all at once by rewinding to a mark.
+// the chunks are kept, so once the arena has grown to the largest request, admission does no
+// heap allocation.
+//
+// a function that draws containers from the arena opens an ArenaScope before declaring them;
+// the scopes of nested calls rewind in LIFO order, and the scope of the placement entry point
+// rewinds the arena when the request is done.
+
+class Arena
+{
+public:
+	struct Mark
+	{
+		size_t chunk,used;
+		Mark():chunk(0),used(0){}
+	};
+	explicit Arena(size_t chunkSize=1<<16):chunkSize(chunkSize),cur(0),used(0){}
+	~Arena()
+	{
+		for (size_t k=0;k<chunks.size();k++)
+			::operator delete(chunks[k].base);
+	}
+	void* allocate(size_t bytes)
+	{
+		bytes=(bytes+alignment-1)&~(alignment-1);
+		if (cur>=chunks.size()||used+bytes>chunks[cur].size)
+			grow(bytes);
+		void* p=chunks[cur].base+used;
+		used+=bytes;
+		return p;
+	}
+	Mark mark() const
+	{
+		Mark m;
+		m.chunk=cur;	m.used=used;
+		return m;
+	}
+	void rewind(const Mark& m){cur=m.chunk;used=m.used;}
+	void reset(){rewind(Mark());}
+	size_t capacity() const		// bytes held by the chunks
+	{
+		size_t n=0;
+		for (size_t k=0;k<chunks.size();k++)
+			n+=chunks[k].size;
+		return n;
+	}
+
+private:
+	enum {alignment=16};
+	struct Chunk
+	{
+		char* base;
+		size_t size;
+	};
+	vector<Chunk> chunks;
+	size_t chunkSize;
+	size_t cur,used;	// the chunk in use and its bytes in use
+	// move to the next chunk that can hold bytes, the chunks too small are skipped
+	void grow(size_t bytes)
+	{
+		if (cur<chunks.size())
+			cur++;
+		while (cur<chunks.size()&&chunks[cur].size<bytes)
+			cur++;
+		if (cur==chunks.size())
+		{
+			Chunk c;
+			c.size=bytes>chunkSize?bytes:chunkSize;
+			c.base=(char*)::operator new(c.size);
+			chunks.push_back(c);
+		}
+		used=0;
+	}
+	Arena(const Arena&);
+	const Arena& operator=(const Arena&);
+};
+
+// rewinds the arena on return
+class ArenaScope
+{
+public:
+	explicit ArenaScope(Arena& a):a(a),m(a.mark()){}
+	~ArenaScope(){a.rewind(m);}
+private:
+	Arena& a;
+	Arena::Mark m;
+	ArenaScope(const ArenaScope&);
+	const ArenaScope& operator=(const ArenaScope&);
+};
+
+// STL allocator of an arena, the heap if there is no arena
+template <class T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+	template <class U> struct rebind {typedef ArenaAllocator<U> other;};
+
+	ArenaAllocator(Arena* arena=0):arena(arena){}
+	ArenaAllocator(Arena& arena):arena(&arena){}
+	template <class U> ArenaAllocator(const ArenaAllocator<U>& a):arena(a.arena){}
+
+	pointer address(reference x) const {return &x;}
+	const_pointer address(const_reference x) const {return &x;}
+	pointer allocate(size_type n,const void* =0)
+	{
+		if (arena)
+			return (pointer)arena->allocate(n*sizeof(T));
+		return (pointer)::operator new(n*sizeof(T));
+	}
+	void deallocate(pointer p,size_type)
+	{
+		if (!arena)
+			::operator delete(p);
+	}
+	size_type max_size() const {return size_t(-1)/sizeof(T);}
+	void construct(pointer p,const T& x){new((void*)p) T(x);}
+	void destroy(pointer p){p->~T();}
+
+	Arena* arena;
+};
+template <class T,class U>
+bool operator==(const ArenaAllocator<T>& a,const ArenaAllocator<U>& b){return a.arena==b.arena;}
+template <class T,class U>
+bool operator!=(const ArenaAllocator<T>& a,const ArenaAllocator<U>& b){return a.arena!=b.arena;}
+
+// ArenaVector<T>::type is a vector in an arena
+template <class T>
+struct ArenaVector
+{
+	typedef vector<T,ArenaAllocator<T> > type;
+};
+
+#endif
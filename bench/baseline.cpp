@@ -0,0 +1,131 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <map>
+#include <vector>
+#include <algorithm>
+using namespace std;
+///////////////////////////////
+// regression check and scaling curves of the results of scale.cpp
+//	baseline compare baseline.txt results.txt [threshold]
+//		fails (exit 1) if a metric of results is worse than in baseline by more than threshold
+//		(relative, default 0.25), or if a success rate changed
+//	baseline scaling results.txt
+//		per topology family, scenario and metric: the value at each size and the local exponent
+//		log(v2/v1)/log(n2/n1) against nServer. exponents near 2 show the quadratic terms.
+
+struct Result
+{
+	string config,scenario,metric;
+	int nServer;
+	double value;
+};
+
+static bool readResults(const char* filename,vector<Result>& results)
+{
+	ifstream in(filename);
+	if (!in)
+	{	cerr << "Cannot open " << filename << "\n";
+		return false;
+	}
+	Result r;
+	while (in >> r.config >> r.nServer >> r.scenario >> r.metric >> r.value)
+		results.push_back(r);
+	return true;
+}
+
+static string key(const Result& r)
+{
+	return r.config+" "+r.scenario+" "+r.metric;
+}
+
+// +1: lower is better, -1: higher is better, 0: must not change
+static int direction(const string& metric)
+{
+	if (metric=="throughput")
+		return -1;
+	if (metric=="success_rate")
+		return 0;
+	return 1;
+}
+
+static int compare(const char* baseFile,const char* resultFile,double threshold)
+{
+	vector<Result> base,cur;
+	if (!readResults(baseFile,base)||!readResults(resultFile,cur))
+		return 2;
+	map<string,double> now;
+	for (size_t i=0;i<cur.size();i++)
+		now[key(cur[i])]=cur[i].value;	// the last run of a key
+	int n_regress=0;
+	printf("%-40s %14s %14s %8s\n","config scenario metric","baseline","current","change");
+	for (size_t i=0;i<base.size();i++)
+	{
+		string k=key(base[i]);
+		map<string,double>::const_iterator it=now.find(k);
+		if (it==now.end())
+		{	printf("%-40s %14g %14s %8s missing\n",k.c_str(),base[i].value,"-","-");
+			continue;
+		}
+		double b=base[i].value,c=it->second;
+		double change=b!=0?(c-b)/fabs(b):(c!=0?1:0);
+		int dir=direction(base[i].metric);
+		bool regress=dir==0?fabs(c-b)>1e-6:dir*change>threshold;
+		if (regress)
+			n_regress++;
+		printf("%-40s %14g %14g %+7.1f%%%s\n",k.c_str(),b,c,100*change,regress?" REGRESSION":"");
+	}
+	printf("%d regressions (threshold %g%%)\n",n_regress,100*threshold);
+	return n_regress>0?1:0;
+}
+
+static bool bySize(const Result& a,const Result& b)
+{
+	return a.nServer<b.nServer;
+}
+
+static int scaling(const char* resultFile)
+{
+	vector<Result> results;
+	if (!readResults(resultFile,results))
+		return 2;
+	// curves: family (the config up to '_'), scenario and metric
+	map<string,vector<Result> > curves;
+	for (size_t i=0;i<results.size();i++)
+	{
+		const Result& r=results[i];
+		if (direction(r.metric)==0)
+			continue;
+		string family=r.config.substr(0,r.config.find('_'));
+		curves[family+" "+r.scenario+" "+r.metric].push_back(r);
+	}
+	printf("%-40s %8s %14s %9s\n","family scenario metric","nServer","value","exponent");
+	for (map<string,vector<Result> >::iterator it=curves.begin();it!=curves.end();++it)
+	{
+		vector<Result>& c=it->second;
+		stable_sort(c.begin(),c.end(),bySize);
+		for (size_t i=0;i<c.size();i++)
+		{
+			printf("%-40s %8d %14g",it->first.c_str(),c[i].nServer,c[i].value);
+			if (i>0&&c[i].nServer>c[i-1].nServer&&c[i].value>0&&c[i-1].value>0)
+				printf(" %9.2f",log(c[i].value/c[i-1].value)/log((double)c[i].nServer/c[i-1].nServer));
+			printf("\n");
+		}
+	}
+	return 0;
+}
+
+int main(int argc,char* argv[])
+{
+	if (argc>=4&&strcmp(argv[1],"compare")==0)
+		return compare(argv[2],argv[3],argc>4?atof(argv[4]):0.25);
+	if (argc>=3&&strcmp(argv[1],"scaling")==0)
+		return scaling(argv[2]);
+	cerr << "usage: " << argv[0] << " compare baseline.txt results.txt [threshold]\n"
+		 << "       " << argv[0] << " scaling results.txt\n";
+	return 2;
+}
@@ -0,0 +1,253 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include "parameter.h"
+#ifdef _Tree
+#include "Trees.h"
+#else
+#include "Graphs.h"
+#endif
+#include "timer.h"
+using namespace std;
+///////////////////////////////
+// micro-benchmarks of the routing and congestion kernels, one executable per topology and size
+// (see the Makefile). the network, the VDC and its placement are drawn from fixed seeds, every
+// kernel runs until minTime seconds have passed and prints ns/op, allocations/op and ops/s.
+//	bench [minTime] [name]		only the kernels whose name contains name
+
+// allocations of the operator new of the whole program. the replacements free what they malloc,
+// GCC does not see it once they are inlined into a new-expression
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+static long long n_alloc=0;
+void* operator new(size_t size)
+{
+	n_alloc++;
+	void* p=malloc(size>0?size:1);
+	if (!p)
+		throw bad_alloc();
+	return p;
+}
+void* operator new[](size_t size){return operator new(size);}
+void operator delete(void* p) throw(){free(p);}
+void operator delete[](void* p) throw(){operator delete(p);}
+
+const int nVM=8;			// VMs of the benchmark VDC
+const float minBw=100,maxBw=400;
+
+#ifdef _Tree
+typedef Tree Engine;
+#else
+typedef Graph Engine;
+#endif
+
+struct Fixture
+{
+	Engine* G;
+	Cluster req;
+	Solution map;
+	float hostBw[nServer];
+	float sumB,res_port_B[nServer];
+	float (*sum_capacity)[nServer];
+	int n;			// rotates the server pairs, edges and servers of the kernels
+	int pairs[nServer*nServer][2];
+	int n_pairs;
+};
+
+// the VM i on server i*stride, so that the VDC spans the racks
+static void place(Fixture& x)
+{
+	for (int i=0;i<nServer;i++)
+		x.hostBw[i]=0;
+	x.map.Clear();
+	int stride=max(nServer/nVM,1);
+	for (int i=0;i<x.req.N;i++)
+	{	int s=(i*stride)%nServer;
+		x.map.addSlot(s,1);
+		x.hostBw[s]+=x.req.B[i];
+	}
+}
+
+static void setup(Fixture& x)
+{
+	Random rng(1);
+	x.G=new Engine;
+#ifdef _Tree
+	x.G->drawTree();
+#endif
+#ifdef _FatTree
+	x.G->drawFattree();
+#endif
+#ifdef _L2VL2
+	x.G->drawL2VL2();
+#endif
+#ifdef _VL2
+	x.G->drawVL2();
+#endif
+#ifdef _Bcube
+	x.G->drawBcube();
+#endif
+	x.G->RandomNetwork(rng,0.5,0.2,0.9);
+	x.req.random(rng,nVM,minBw,maxBw);
+	x.n=0;
+	x.n_pairs=0;
+	for (int s=0;s<nServer;s++)
+		for (int d=0;d<nServer;d++)
+			if (s!=d)
+			{	x.pairs[x.n_pairs][0]=s;
+				x.pairs[x.n_pairs][1]=d;
+				x.n_pairs++;
+			}
+#ifdef _Tree
+	x.G->allocateAR(nVM);
+	x.G->clearLoad();
+	x.sumB=0;
+	for (int i=0;i<nServer;i++)
+		x.res_port_B[i]=0;
+	x.G->QuickFail(x.req,x.sumB,x.res_port_B);
+	place(x);
+	for (int s=0;s<nServer;s++)
+		if (x.hostBw[s]>0)
+			x.G->updateLoad(s,x.hostBw[s]);
+#else
+	x.G->computeRoutes();
+	x.sum_capacity=new float[nServer][nServer];
+	x.sumB=0;
+	for (int i=0;i<nServer;i++)
+		x.res_port_B[i]=0;
+	x.G->QuickFail(x.req,x.map,x.sum_capacity,x.sumB,x.res_port_B);	// load balance routing and Sort_fsd
+	place(x);
+#endif
+}
+
+#ifdef _Tree
+// one more VM on server s and the congestion check, then undone, as in the placements
+static void b_congestDetect(Fixture& x)
+{
+	int s=x.n%nServer;
+	x.G->updateLoad(s,x.hostBw[s]+minBw);
+	x.G->CongestDetect(s,x.req,x.hostBw,x.sumB,x.map);
+	x.G->updateLoad(s,x.hostBw[s]);
+}
+static void b_greedyAR(Fixture& x)
+{
+	Solution map;
+	x.G->GreedyARAllocation(x.req,map);	// sorts req.B, the same every time
+}
+#else
+static void b_dijkstra(Fixture& x)
+{
+	int* p=x.pairs[x.n%x.n_pairs];
+	x.G->Dijkstra(p[0],p[1]);
+}
+static void b_yenKSP(Fixture& x)
+{
+	int* p=x.pairs[x.n%x.n_pairs];
+	x.G->YenKSP(p[0],p[1]);
+}
+static void b_yenKSP_all(Fixture& x)
+{
+	x.G->computeRoutes();
+}
+static void b_loadBalance(Fixture& x)
+{
+	int* p=x.pairs[x.n%x.n_pairs];
+	x.G->LoadBalance(p[0],p[1]);
+}
+static void b_ECMP(Fixture& x)
+{
+	int* p=x.pairs[x.n%x.n_pairs];
+	x.G->ECMP(p[0],p[1]);
+}
+static void b_sort_fsd(Fixture& x)
+{
+	x.G->Sort_fsd(x.n%Ne);
+}
+static void b_maxTraffic(Fixture& x)
+{
+	x.G->maxTraffic(x.n%Ne,x.hostBw);
+}
+static void b_LPmaxTraffic(Fixture& x)
+{
+	x.G->LPmaxTraffic(x.n%Ne,x.hostBw);
+}
+static void b_congestDetect(Fixture& x)
+{
+	x.G->CongestDetect(x.n%nServer,x.req,x.hostBw,x.sum_capacity,x.map);
+}
+#endif
+
+struct Benchmark
+{
+	const char* name;
+	void (*run)(Fixture& x);
+	bool once;		// long kernels: a single call per round
+};
+
+static void measure(const Benchmark& b,Fixture& x,double minTime)
+{
+	long long iterations=0,allocations=0;
+	double elapsed=0;
+	long long n=1;
+	while (elapsed<minTime)
+	{
+		long long a0=n_alloc;
+		Timer timer;
+		for (long long i=0;i<n;i++,x.n++)
+			b.run(x);
+		elapsed+=timer.elapsed();
+		allocations+=n_alloc-a0;
+		iterations+=n;
+		if (!b.once)
+			n*=2;
+	}
+	double ns=1e9*elapsed/iterations;
+	printf("%-16s %14.1f %12.2f %14.1f %10lld\n",b.name,ns,(double)allocations/iterations,1e9/ns,iterations);
+}
+
+static const char* topology()
+{
+#if defined(_Tree)
+	return "Tree";
+#elif defined(_FatTree)
+	return "FatTree";
+#elif defined(_L2VL2)
+	return "L2VL2";
+#elif defined(_VL2)
+	return "VL2";
+#else
+	return "Bcube";
+#endif
+}
+
+int main(int argc,char* argv[])
+{
+	double minTime=argc>1?atof(argv[1]):0.5;
+	const char* filter=argc>2?argv[2]:"";
+	const Benchmark benchmarks[]={
+#ifdef _Tree
+		{"CongestDetect",b_congestDetect,false},
+		{"GreedyAR",b_greedyAR,false},
+#else
+		{"Dijkstra",b_dijkstra,false},
+		{"YenKSP",b_yenKSP,false},
+		{"YenKSP_all",b_yenKSP_all,true},
+		{"ECMP",b_ECMP,false},
+		{"LoadBalance",b_loadBalance,false},	// after ECMP: LoadBalance leaves f as set up
+		{"Sort_fsd",b_sort_fsd,false},
+		{"maxTraffic",b_maxTraffic,false},
+		{"LPmaxTraffic",b_LPmaxTraffic,false},
+		{"CongestDetect",b_congestDetect,false},
+#endif
+	};
+	Fixture& x=*new Fixture;
+	Timer timer;
+	setup(x);
+	printf("# %s nServer=%d Nv=%d Ne=%d setup=%.3fs\n",topology(),nServer,Nv,Ne,timer.elapsed());
+	printf("%-16s %14s %12s %14s %10s\n","kernel","ns/op","allocs/op","ops/s","iterations");
+	for (size_t k=0;k<sizeof(benchmarks)/sizeof(benchmarks[0]);k++)
+		if (strstr(benchmarks[k].name,filter))
+			measure(benchmarks[k],x,minTime);
+	return 0;
+}
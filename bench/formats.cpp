@@ -0,0 +1,52 @@
+#include <cstdio>
+#include <iostream>
+#include "topology.h"
+#include "trace.h"
+using namespace std;
+///////////////////////////////
+// checks of the file formats: each one loads its own files and rejects the others
+//	formats dir
+// writes a small topology and a small trace into dir, exits with 1 if a check fails
+
+static int n_failed=0;
+
+static void check(bool ok,const char* what)
+{
+	cout << (ok?"ok     ":"FAILED ") << what << "\n";
+	if (!ok)
+		n_failed++;
+}
+
+int main(int argc,char* argv[])
+{
+	if (argc<2)
+	{	cerr << "usage: formats dir\n";
+		return 2;
+	}
+	string topologyFile=string(argv[1])+"/formats.vdcg";
+	string traceFile=string(argv[1])+"/formats.trace";
+
+	// a server and a switch
+	Topology topo;
+	topo.create(2);
+	topo.setServer(0,4);
+	topo.addLink(0,1,1,1000);
+	topo.finish();
+	if (!topo.save(topologyFile.c_str()))
+		return 1;
+	Random rng(1);
+	RandomRequests source(rng,0.5f,4,4,1);
+	if (writeTrace(source,traceFile.c_str(),10)!=10)
+		return 1;
+
+	Topology t;
+	check(t.load(topologyFile.c_str())&&t.nNode==2&&t.nLink==1,"Topology::load of a topology");
+	t.close();
+	check(!t.load(traceFile.c_str()),"Topology::load rejects a request trace");
+	TraceReader reader;
+	Cluster req;
+	check(reader.open(traceFile.c_str())&&reader.next(req),"TraceReader::open of a request trace");
+	reader.close();
+	check(!reader.open(topologyFile.c_str()),"TraceReader::open rejects a topology");
+	return n_failed>0?1:0;
+}
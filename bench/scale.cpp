@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "parameter.h"
+#ifdef _Tree
+#include "Trees.h"
+#else
+#include "Graphs.h"
+#endif
+#include "timer.h"
+#include "latency.h"
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+using namespace std;
+///////////////////////////////
+// end-to-end benchmark of the standard static and dynamic scenarios, one executable per
+// topology and size (see the Makefile). every scenario runs repeat times from the same seed and
+// the fastest run is kept. one line per metric is appended to the results file:
+//	config nServer scenario metric value
+// metrics: time (s), throughput (requests/s), latency_mean, latency_p50, latency_p99 (us per
+// request), success_rate, and the peak resident memory of the process (scenario "process", KB).
+// baseline.cpp compares the results with a baseline and draws the scaling curves.
+//	scale results.txt [repeat]
+
+const int numOfStatic=100,numOfDynamic=300;
+const int nVM=6;
+const float minBw=100,maxBw=400,load=0.6f;
+
+#ifdef _Tree
+typedef Tree Engine;
+#else
+typedef Graph Engine;
+#endif
+
+static string config()
+{
+	char s[64];
+#if defined(_Tree)
+	sprintf(s,"Tree_H%d",H);
+#elif defined(_FatTree)
+	sprintf(s,"FatTree_H%d",H);
+#elif defined(_L2VL2)
+	sprintf(s,"L2VL2");
+#elif defined(_VL2)
+	sprintf(s,"VL2_%dx%d",DA,DI);
+#else
+	sprintf(s,"Bcube_H%d",H);
+#endif
+	return s;
+}
+
+static long peakRSS()	// KB
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(),&pmc,sizeof(pmc)))
+		return 0;
+	return (long)(pmc.PeakWorkingSetSize/1024);
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF,&usage);
+	return usage.ru_maxrss;
+#endif
+}
+
+static void draw(Engine& G)
+{
+#ifdef _Tree
+	G.drawTree();
+#endif
+#ifdef _FatTree
+	G.drawFattree();
+#endif
+#ifdef _L2VL2
+	G.drawL2VL2();
+#endif
+#ifdef _VL2
+	G.drawVL2();
+#endif
+#ifdef _Bcube
+	G.drawBcube();
+#endif
+}
+
+struct Scenario
+{
+	const char* name;
+	char algorithm;
+	bool dynamic;
+};
+
+// returns the success rate
+static float run(Engine& G,const Scenario& c)
+{
+	float max_utilization,success_rate,bandwidth_cost,RC;
+#ifdef _Tree
+	if (c.dynamic)
+		G.ProcessRequest(c.algorithm,numOfDynamic,load,max_utilization,success_rate,bandwidth_cost,RC);
+	else
+		G.SingleRequest(c.algorithm,numOfStatic,0.5,0.2,0.9,nVM,minBw,maxBw,max_utilization,success_rate,bandwidth_cost);
+#else
+	if (c.dynamic)
+		G.ProcessRequest(c.algorithm,false,numOfDynamic,load,max_utilization,success_rate,bandwidth_cost,RC);
+	else
+		G.SingleRequest(c.algorithm,false,numOfStatic,0.5,0.2,0.9,nVM,nVM,minBw,maxBw,max_utilization,success_rate,bandwidth_cost);
+#endif
+	return success_rate;
+}
+
+int main(int argc,char* argv[])
+{
+	if (argc<2)
+	{	cerr << "usage: " << argv[0] << " results.txt [repeat]\n";
+		return 1;
+	}
+	int repeat=argc>2?atoi(argv[2]):3;
+	ofstream out(argv[1],ios::app);
+	if (!out)
+	{	cerr << "Cannot open " << argv[1] << "\n";
+		return 1;
+	}
+	const Scenario scenarios[]={
+#ifdef _Tree
+		{"static_P",'P',false},
+		{"static_A",'A',false},
+#else
+		{"static_P",'P',false},
+		{"static_F",'F',false},
+#endif
+#ifdef _FatTree
+		// BestFit solves the congestion LP of the edges (maxTrafficFlow without CPLEX), whose
+		// min cost flow once looped forever on FatTree H=4
+		{"static_G",'G',false},
+#endif
+		{"dynamic_P",'P',true},
+		{"dynamic_F",'F',true},
+	};
+	string name=config();
+	Engine& G=*new Engine;
+	draw(G);
+	PhaseProfile profile;
+	G.profile=&profile;
+	for (size_t k=0;k<sizeof(scenarios)/sizeof(scenarios[0]);k++)
+	{
+		const Scenario& c=scenarios[k];
+		double best=Infinity;
+		float success_rate=0;
+		PhaseProfile fastest;
+		for (int r=0;r<repeat;r++)
+		{
+			profile.clear();
+			Timer timer;
+			success_rate=run(G,c);
+			double t=timer.elapsed();
+			if (t<best)
+			{	best=t;
+				fastest=profile;
+			}
+		}
+		const LatencyHistogram& h=fastest.histogram[PhaseProfile::TOTAL];
+		const char* s=c.name;
+		out << name << " " << nServer << " " << s << " time " << best << "\n";
+		out << name << " " << nServer << " " << s << " throughput " << h.count()/best << "\n";
+		out << name << " " << nServer << " " << s << " latency_mean " << h.mean() << "\n";
+		out << name << " " << nServer << " " << s << " latency_p50 " << h.quantile(0.5f) << "\n";
+		out << name << " " << nServer << " " << s << " latency_p99 " << h.quantile(0.99f) << "\n";
+		out << name << " " << nServer << " " << s << " success_rate " << success_rate << "\n";
+		cout << name << " " << s << ": " << best << "s, " << h.count()/best << " requests/s\n";
+	}
+	out << name << " " << nServer << " process peak_rss " << peakRSS() << "\n";
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "generators.h"
+#include "timer.h"
+using namespace std;
+///////////////////////////////
+// generates a topology for the scaling experiments and saves it as a binary topology file,
+// which Graph::drawGragh maps if it fits the sizes of parameter.h
+//	topogen fattree k out
+//	topogen vl2 DA DI serversPerToR out
+//	topogen bcube n k out
+//	topogen dcell n k out
+//	topogen leafspine nLeaf nSpine serversPerLeaf oversubscription out
+//	topogen jellyfish nSwitch ports serversPerSwitch seed out
+// the servers get SLOT VM slots, the links BW Mbps (default 4 and 1000)
+
+static void usage()
+{
+	cerr << "usage: topogen fattree k | vl2 DA DI serversPerToR | bcube n k | dcell n k |\n"
+		"\tleafspine nLeaf nSpine serversPerLeaf oversubscription |\n"
+		"\tjellyfish nSwitch ports serversPerSwitch seed   output\n";
+	exit(2);
+}
+
+int main(int argc,char* argv[])
+{
+	if (argc<4)
+		usage();
+	const char* kind=argv[1];
+	const char* output=argv[argc-1];
+	int n_arg=argc-3;
+	int a[4]={0,0,0,0};
+	for (int i=0;i<n_arg&&i<4;i++)
+		a[i]=atoi(argv[2+i]);
+	int slot=getenv("SLOT")?atoi(getenv("SLOT")):4;
+	float bw=getenv("BW")?(float)atof(getenv("BW")):1000;
+
+	Topology topo;
+	bool ok=false;
+	Timer timer;
+	if (strcmp(kind,"fattree")==0&&n_arg==1)
+		ok=generateFatTree(topo,a[0],slot,bw);
+	else if (strcmp(kind,"vl2")==0&&n_arg==3)
+		ok=generateVL2(topo,a[0],a[1],a[2],slot,bw);
+	else if (strcmp(kind,"bcube")==0&&n_arg==2)
+		ok=generateBCube(topo,a[0],a[1],slot,bw);
+	else if (strcmp(kind,"dcell")==0&&n_arg==2)
+		ok=generateDCell(topo,a[0],a[1],slot,bw);
+	else if (strcmp(kind,"leafspine")==0&&n_arg==4)
+		ok=generateLeafSpine(topo,a[0],a[1],a[2],slot,bw,(float)atof(argv[5]));
+	else if (strcmp(kind,"jellyfish")==0&&n_arg==4)
+	{	Random rng(a[3]);
+		ok=generateJellyfish(topo,a[0],a[1],a[2],slot,bw,bw,rng);
+	}
+	else
+		usage();
+	double elapsed=timer.elapsed();
+	if (!ok||!topo.save(output))
+		return 1;
+	int n_server=0;
+	for (int v=0;v<topo.nNode;v++)
+		if (topo.slot[v]>=0)
+			n_server++;
+	printf("%s: %d servers, %d nodes, %d links, generated in %.3f s\n",output,n_server,topo.nNode,
+		topo.nLink,elapsed);
+	return 0;
+}
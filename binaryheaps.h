@@ -15,6 +15,7 @@ using namespace std;
 // bool isEmpty( )        --> Return true if empty; else false
 // bool isFull( )         --> Return true if full; else false
 // void makeEmpty( )      --> Remove all items
+// void reserve( n )      --> Make room for n items
 // ******************ERRORS********************************
 // Throws Underflow and Overflow as warranted
 
@@ -31,6 +32,22 @@ class BinaryHeap
     Type deleteMin( );
     void deleteMin( Type & minItem );
     void makeEmpty( );
+    void reserve( int capacity );
+    // the heap Array, for the checkpoints
+    template <class Archive> void save( Archive & ar ) const
+    {
+        ar.put( currentSize );
+        ar.put( &Array[ 1 ], currentSize );
+    }
+    template <class Archive> void load( Archive & ar )
+    {
+        ar.get( currentSize );
+        if( currentSize < 0 )
+            currentSize = 0;
+        if( currentSize + 1 > (int)Array.size( ) )
+            Array.resize( currentSize + 1 );
+        ar.get( &Array[ 1 ], currentSize );
+    }
 	
   private:
     int  currentSize;  // Number of elements in heap
@@ -150,6 +167,16 @@ void BinaryHeap<Type>::makeEmpty( )
     currentSize = 0;
 }
 
+/**
+ * Make room for capacity items, the memory is kept for the next use.
+ */
+template <class Type>
+void BinaryHeap<Type>::reserve( int capacity )
+{
+    if( capacity + 1 > (int)Array.size( ) )
+        Array.resize( capacity + 1 );
+}
+
 /**
  * Internal method to percolate down in the heap.
  * hole is the index at which the percolate begins.
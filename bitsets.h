@@ -0,0 +1,207 @@
+#ifndef bitsets_H
+#define bitsets_H
+#include <vector>
+#include <algorithm>
+#include "parameter.h"
+#include "elements.h"
+#include "counters.h"
+#include "arena.h"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+///////////////////////////////
+// word-wide bitsets used to filter the candidate servers of the placement loops
+
+#ifdef _MSC_VER
+typedef unsigned long set_word;			//_BitScanForward works on 32-bit words
+#else
+typedef unsigned long long set_word;
+#endif
+const int set_word_bits=8*sizeof(set_word);
+
+// index of the lowest set bit of w, w must not be zero
+inline int ctz(set_word w)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index,w);
+	return (int)index;
+#else
+	return __builtin_ctzll(w);
+#endif
+}
+
+// number of set bits of w
+inline int popcount(set_word w)
+{
+	int n=0;
+	for (;w;w&=w-1)
+		n++;
+	return n;
+}
+
+// set the bits low,...,up of the word array w
+inline void setBits(set_word* w,int low,int up)
+{
+	if (low>up)
+		return;
+	int kl=low/set_word_bits,ku=up/set_word_bits;
+	set_word ml=~(set_word)0<<(low%set_word_bits);
+	set_word mu=~(set_word)0>>(set_word_bits-1-up%set_word_bits);
+	if (kl==ku)
+	{	w[kl]|=ml&mu;
+		return;
+	}
+	w[kl]|=ml;
+	for (int k=kl+1;k<ku;k++)
+		w[k]=~(set_word)0;
+	w[ku]|=mu;
+}
+// the first set bit n of w with from<=n<len, len if there is none
+inline int nextSetBit(const set_word* w,int from,int len)
+{
+	if (from>=len)
+		return len;
+	int k=from/set_word_bits,nw=(len+set_word_bits-1)/set_word_bits;
+	set_word c=w[k]&(~(set_word)0<<(from%set_word_bits));
+	while (!c)
+	{	if (++k>=nw)
+			return len;
+		c=w[k];
+	}
+	return min(k*set_word_bits+ctz(c),len);
+}
+// the first clear bit n of w with from<=n<len, len if there is none
+inline int nextClearBit(const set_word* w,int from,int len)
+{
+	if (from>=len)
+		return len;
+	int k=from/set_word_bits,nw=(len+set_word_bits-1)/set_word_bits;
+	set_word c=~w[k]&(~(set_word)0<<(from%set_word_bits));
+	while (!c)
+	{	if (++k>=nw)
+			return len;
+		c=~w[k];
+	}
+	return min(k*set_word_bits+ctz(c),len);
+}
+
+// allocation ranges of all the tree nodes in one contiguous bitset arena.
+// row (v,x,y) holds AR[v](x,y,n), n=0,...,y-x+1, for the VMs x,...,y of the request
+struct allocateRange
+{
+	int nNode;	// number of nodes
+	int n;		// number of VMs
+	int nWord;	// words of a row
+	vector<set_word> bits;
+
+	allocateRange():nNode(0),n(0),nWord(0){}
+	void resize(int nV,int nVM)
+	{
+		nNode=nV;	n=nVM;
+		nWord=(n+1+set_word_bits-1)/set_word_bits;
+		bits.assign((nNode*n*n+2)*nWord,0);	// two more rows for scratch
+	}
+	void release(){bits.clear();nNode=n=nWord=0;}
+	set_word* row(int v,int x,int y){return &bits[((v*n+x)*n+y)*nWord];}
+	const set_word* row(int v,int x,int y) const {return &bits[((v*n+x)*n+y)*nWord];}
+	set_word* scratch(int k){return &bits[(nNode*n*n+k)*nWord];}
+	bool operator () (int v,int x,int y,int i) const
+	{
+		return (row(v,x,y)[i/set_word_bits]>>(i%set_word_bits))&1;
+	}
+	int nextSet(int v,int x,int y,int from,int len) const {return nextSetBit(row(v,x,y),from,len);}
+	int nextClear(int v,int x,int y,int from,int len) const {return nextClearBit(row(v,x,y),from,len);}
+};
+
+// a set of servers, one bit per server of Topo
+template <class Topo>
+class ServerSetT
+{
+public:
+	enum{nWord=(Topo::nServer+set_word_bits-1)/set_word_bits};
+	set_word w[nWord];
+
+	ServerSetT(){Clear();}
+	void Clear(){for(int k=0;k<nWord;k++) w[k]=0;}
+	bool test(int x) const {return (w[x/set_word_bits]>>(x%set_word_bits))&1;}
+	void set(int x){w[x/set_word_bits]|=(set_word)1<<(x%set_word_bits);}
+	void reset(int x){w[x/set_word_bits]&=~((set_word)1<<(x%set_word_bits));}
+	void assign(int x,bool value){if(value) set(x); else reset(x);}
+	// the first server after x in this set and not in exclude, Topo::nServer if there is none
+	int nextNotIn(const ServerSetT& exclude,int x) const
+	{
+		x++;
+		int k=x/set_word_bits;
+		set_word mask=~(set_word)0<<(x%set_word_bits);
+		for (;k<nWord;k++,mask=~(set_word)0)
+		{
+			set_word c=w[k]&~exclude.w[k]&mask;
+			if (c)
+				return k*set_word_bits+ctz(c);
+		}
+		return Topo::nServer;
+	}
+};
+typedef ServerSetT<CompiledTopology> ServerSet;
+
+// candidate servers of every VM of a request:
+// a free VM slot & enough residual port bandwidth for VM(Bi) & not in the tabu list of VM(Bi).
+// update(x) must be called whenever map.Slot[x] or hostBw[x] is changed.
+// port and tabu are drawn from arena if one is given.
+template <class Topo>
+class CandidateServersT
+{
+public:
+	typedef ServerSetT<Topo> Set;
+	Set slot;				// servers with a free VM slot
+	typename ArenaVector<Set>::type port;	// port[i]: servers whose residual port bandwidth can host VM(Bi)
+	typename ArenaVector<Set>::type tabu;	// tabu[i]: servers which VM(Bi) is not allowed to be placed to
+
+	CandidateServersT(const Cluster& req,float sumB,const float* res_port_B,const float* hostBw,Arena* arena=0)
+		:port(req.N,Set(),arena),tabu(req.N,Set(),arena),req(req),sumB(sumB),res_port_B(res_port_B),hostBw(hostBw){}
+
+	// recompute the bits of server x after its slot or host bandwidth is changed, O(N)
+	void update(int x,bool freeSlot)
+	{
+		slot.assign(x,freeSlot);
+		for (int i=0;i<req.N;i++)
+			port[i].assign(x,!(res_port_B[x]<min(hostBw[x]+req.B[i],sumB-hostBw[x]-req.B[i])));
+	}
+	bool test(int i,int x) const
+	{
+		return slot.test(x)&&port[i].test(x)&&!tabu[i].test(x);
+	}
+	// the first candidate server of VM(Bi) after server x, nServer if there is none
+	int next(int i,int x) const
+	{
+		x++;
+		int k=x/set_word_bits;
+		set_word mask=~(set_word)0<<(x%set_word_bits);
+		for (;k<Set::nWord;k++,mask=~(set_word)0)
+		{
+			set_word c=slot.w[k]&port[i].w[k]&~tabu[i].w[k]&mask;
+#ifdef _counters
+			// the tabu candidates before the returned server
+			set_word t=slot.w[k]&port[i].w[k]&tabu[i].w[k]&mask;
+			if (c)
+				t&=((set_word)1<<ctz(c))-1;
+			COUNT_N(CNT_TABU_HIT,popcount(t));
+#endif
+			if (c)
+				return k*set_word_bits+ctz(c);
+		}
+		return Topo::nServer;
+	}
+	int first(int i) const {return next(i,-1);}
+
+private:
+	const Cluster& req;
+	float sumB;
+	const float* res_port_B;
+	const float* hostBw;
+};
+typedef CandidateServersT<CompiledTopology> CandidateServers;
+
+#endif
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include "checkpoint.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+using namespace std;
+
+Checkpoint::Checkpoint(const char* filename,int interval,bool resume)
+	:filename(filename),interval(interval),resume(resume)
+{
+}
+
+Checkpoint::~Checkpoint()
+{
+	wait();
+}
+
+void Checkpoint::wait()
+{
+#ifdef _background_io
+	if (writer.joinable())
+		writer.join();
+#endif
+}
+
+void Checkpoint::write(Snapshot& s)
+{
+	wait();
+	pending.data.swap(s.data);
+	s.data.clear();
+	s.pos=0;
+#ifdef _background_io
+	writer=thread(&Checkpoint::flush,this);
+#else
+	flush();
+#endif
+}
+
+void Checkpoint::flush()
+{
+	string tmp=filename+".tmp";
+	ofstream out(tmp.c_str(),ios::out|ios::binary);
+	if (!out) {
+		cerr << "Cannot open " << tmp << " for output\n";
+		return;
+	}
+	unsigned int size=(unsigned int)pending.data.size();
+	out.write(checkpointMagic,4);
+	out.write((const char*)&checkpointVersion,sizeof(checkpointVersion));
+	out.write((const char*)&size,sizeof(size));
+	if (size>0)
+		out.write(&pending.data[0],size);
+	out.close();
+	if (!out) {
+		cerr << "Cannot write the checkpoint " << tmp << "\n";
+		return;
+	}
+	// the old checkpoint is replaced atomically, a crash leaves the old or the new one
+#ifdef _WIN32
+	if (!MoveFileExA(tmp.c_str(),filename.c_str(),MOVEFILE_REPLACE_EXISTING|MOVEFILE_WRITE_THROUGH))
+#else
+	if (rename(tmp.c_str(),filename.c_str())!=0)
+#endif
+		cerr << "Cannot rename " << tmp << " to " << filename << "\n";
+}
+
+bool Checkpoint::read(Snapshot& s)
+{
+	wait();
+	if (readFile(filename,s,false))
+		return true;
+	// a complete snapshot that was not renamed yet
+	string tmp=filename+".tmp";
+	if (!readFile(tmp,s,true))
+		return false;
+	cerr << "Resuming from " << tmp << "\n";
+	return true;
+}
+
+bool Checkpoint::readFile(const string& name,Snapshot& s,bool quiet)
+{
+	ifstream in(name.c_str(),ios::in|ios::binary);
+	if (!in) {
+		if (!quiet)
+			cerr << "Cannot open " << name << " for input\n";
+		return false;
+	}
+	char magic[4];
+	unsigned int version=0,size=0;
+	in.read(magic,4);
+	in.read((char*)&version,sizeof(version));
+	in.read((char*)&size,sizeof(size));
+	if (!in||memcmp(magic,checkpointMagic,4)!=0||version!=checkpointVersion) {
+		if (!quiet)
+			cerr << name << " is not a checkpoint of version " << checkpointVersion << "\n";
+		return false;
+	}
+	s.data.resize(size);
+	s.pos=0;
+	s.ok=true;
+	if (size>0)
+		in.read(&s.data[0],size);
+	if (!in) {
+		if (!quiet)
+			cerr << name << " is truncated\n";
+		return false;
+	}
+	return true;
+}
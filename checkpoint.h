@@ -0,0 +1,165 @@
+#ifndef checkpoint_H
+#define checkpoint_H
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include "parameter.h"
+#ifdef _background_io
+#include <thread>
+#endif
+#include "frandom.h"
+#include "events.h"
+#include "steady.h"
+using namespace std;
+///////////////////////////////
+// checkpoints of the dynamic runs (ProcessRequest).
+//
+// a snapshot holds the random stream, the residual slots and bandwidths, the counters,
+// the embeddings of the VDCs in the network, the departure queue and the steady state
+// batches, as raw bytes, so that a resumed run continues bit-identically. the file is
+// "VDCK", uint32 version, uint32 size, then the snapshot.
+
+// byte buffer of a snapshot, the types must be plain data
+class Snapshot
+{
+public:
+	vector<char> data;
+	size_t pos;		// read position
+	bool ok;		// false after a read behind the end
+	Snapshot():pos(0),ok(true){}
+
+	template <class Type> void put(const Type* x,int n)
+	{
+		if (n>0)
+			data.insert(data.end(),(const char*)x,(const char*)x+n*sizeof(Type));
+	}
+	template <class Type> void put(const Type& x){put(&x,1);}
+	template <class Type> void put(const vector<Type>& x)
+	{
+		put((int)x.size());
+		if (!x.empty())
+			put(&x[0],(int)x.size());
+	}
+	template <class Type> void get(Type* x,int n)
+	{
+		size_t len=n>0?n*sizeof(Type):0;
+		if (!ok||pos+len>data.size())
+		{	ok=false;
+			return;
+		}
+		if (len>0)
+			memcpy(x,&data[pos],len);
+		pos+=len;
+	}
+	template <class Type> void get(Type& x){get(&x,1);}
+	template <class Type> void get(vector<Type>& x)
+	{
+		int n=0;
+		get(n);
+		if (!ok||n<0||pos+n*sizeof(Type)>data.size())
+		{	ok=false;
+			return;
+		}
+		x.resize(n);
+		if (n>0)
+			get(&x[0],n);
+	}
+};
+
+const char checkpointMagic[4]={'V','D','C','K'};
+const unsigned int checkpointVersion=2;	// 2: the clock of RunState is a double
+
+class Checkpoint
+{
+public:
+	// a snapshot every interval requests (0: none), resume: continue the run of the file
+	explicit Checkpoint(const char* filename,int interval=10000,bool resume=false);
+	~Checkpoint();
+	string filename;
+	int interval;
+	bool resume;
+	bool due(int n_req) const {return interval>0&&n_req%interval==0;}
+	// write s (emptied) in the background, the previous snapshot is written first. without
+	// _background_io (parameter.h) s is written before write returns.
+	// the file is replaced only after the new one is complete.
+	void write(Snapshot& s);
+	bool read(Snapshot& s);		// the file, or its complete .tmp if the file is missing or bad
+	void wait();	// the background write is finished
+
+private:
+	Snapshot pending;
+#ifdef _background_io
+	thread writer;
+#endif
+	void flush();
+	bool readFile(const string& name,Snapshot& s,bool quiet);
+	Checkpoint(const Checkpoint&);
+	Checkpoint& operator=(const Checkpoint&);
+};
+
+// the topology and the algorithm a snapshot belongs to
+struct RunSignature
+{
+	char engine,algorithm;
+	int nv,ne,nserver,maxslot;
+	RunSignature():engine(0),algorithm(0),nv(0),ne(0),nserver(0),maxslot(0){}
+	// a run of algorithm on an engine of the topology Topo
+	template <class Topo> static RunSignature of(char algorithm)
+	{
+		RunSignature x;
+		x.engine=Topo::family==TopologyTraits::TreeFamily?'T':'G';
+		x.algorithm=algorithm;
+		x.nv=Topo::Nv;	x.ne=Topo::Ne;	x.nserver=Topo::nServer;	x.maxslot=Topo::maxSlot;
+		return x;
+	}
+	bool operator==(const RunSignature& x) const
+	{
+		return engine==x.engine&&algorithm==x.algorithm&&nv==x.nv&&ne==x.ne&&nserver==x.nserver&&maxslot==x.maxslot;
+	}
+};
+
+// the topology of an engine, the compiled one unless the engine is specialized (see graphs.h)
+template <class Engine>
+struct EngineTopology
+{
+	typedef CompiledTopology type;
+};
+
+template <class Engine>
+void saveRun(Snapshot& s,const Engine& G,char algorithm,const RunState& run)
+{
+	s.put(RunSignature::of<typename EngineTopology<Engine>::type>(algorithm));
+	G.rng.save(s);
+	G.saveNetwork(s);
+	run.save(s);
+	s.put((char)(G.steadyState!=0));
+	if (G.steadyState)
+		G.steadyState->save(s);
+}
+
+// false if the snapshot is not of this topology and algorithm, or is truncated
+template <class Engine>
+bool loadRun(Snapshot& s,Engine& G,char algorithm,RunState& run)
+{
+	RunSignature x;
+	s.get(x);
+	if (!s.ok||!(x==RunSignature::of<typename EngineTopology<Engine>::type>(algorithm)))
+	{	cerr << "the checkpoint is not of this topology and algorithm\n";
+		return false;
+	}
+	G.rng.load(s);
+	G.loadNetwork(s);
+	run.load(s);
+	char steady=0;
+	s.get(steady);
+	if (steady&&G.steadyState)
+		G.steadyState->load(s);
+	if (!s.ok||(steady!=0)!=(G.steadyState!=0))
+	{	cerr << "the checkpoint is truncated or its steady state detection does not match\n";
+		return false;
+	}
+	return true;
+}
+
+#endif
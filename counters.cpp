@@ -0,0 +1,47 @@
+#include "counters.h"
+using namespace std;
+
+#ifdef _counters
+THREAD_LOCAL CounterSet threadCounters;
+#endif
+
+CounterSet& currentCounters()
+{
+#ifdef _counters
+	return threadCounters;
+#else
+	static CounterSet none={{0}};
+	return none;
+#endif
+}
+
+void mergeCounters(CounterSet& total,const CounterSet& x)
+{
+	// an OpenMP critical section, the old compilers of THREAD_LOCAL (counters.h) have no std::mutex
+	#pragma omp critical(mergeCounters)
+	total.merge(x);
+}
+
+const char* CounterSet::name(int c)
+{
+	const char* names[nCounter]={"yenksp","dijkstra","loadbalance","ecmp","sort_fsd","congest_detect",
+		"edge","lp_greedy","lp_solve","pertubation_drop","backtrack","tabu_hit"};
+	return names[c];
+}
+
+string CounterSet::header()
+{
+	string s;
+	for (int c=0;c<nCounter;c++)
+	{	if (c>0)
+			s+=" ";
+		s+=name(c);
+	}
+	return s;
+}
+
+void CounterSet::write(ostream& out) const
+{
+	for (int c=0;c<nCounter;c++)
+		out<<(c>0?" ":"")<<count[c];
+}
@@ -0,0 +1,61 @@
+#ifndef counters_H
+#define counters_H
+#include <iostream>
+#include <string>
+using namespace std;
+///////////////////////////////
+// hot path event counters of the routing, placement and congestion code.
+//
+// COUNT(c) adds one to counter c of the calling thread, COUNT_N(c,n) adds n. without
+// _counters the macros are empty and cost nothing. a run reads the counters of its
+// thread (runSweep clears them before a point and copies them after it), mergeCounters
+// adds them to a total shared by the threads.
+
+//#define _counters	// enable the counters
+
+enum Counter
+{
+	CNT_YENKSP,				// YenKSP calls
+	CNT_DIJKSTRA,			// Dijkstra calls
+	CNT_LOADBALANCE,		// LoadBalance refreshes
+	CNT_ECMP,				// ECMP refreshes
+	CNT_SORT_FSD,			// Sort_fsd calls
+	CNT_CONGEST_DETECT,		// CongestDetect calls
+	CNT_EDGE,				// edges whose max traffic is evaluated
+	CNT_LP_GREEDY,			// LPmaxTraffic answered by the greedy bound
+	CNT_LP_SOLVE,			// LPmaxTraffic solved by the LP
+	CNT_PERTUBATION_DROP,	// VMs unloaded from a bottleneck server by Pertubation
+	CNT_BACKTRACK,			// backtracks of BackTracking
+	CNT_TABU_HIT,			// candidate servers skipped because they are tabu
+	nCounter
+};
+
+struct CounterSet
+{
+	long long count[nCounter];
+	void clear(){for (int c=0;c<nCounter;c++) count[c]=0;}
+	void merge(const CounterSet& x){for (int c=0;c<nCounter;c++) count[c]+=x.count[c];}
+	static const char* name(int c);
+	static string header();			// the names separated by spaces
+	void write(ostream& out) const;	// the counts separated by spaces
+};
+
+#ifdef _counters
+#if defined(_MSC_VER)&&_MSC_VER<1900
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL thread_local
+#endif
+extern THREAD_LOCAL CounterSet threadCounters;		// zero initialized
+#define COUNT(c)		(threadCounters.count[c]++)
+#define COUNT_N(c,n)	(threadCounters.count[c]+=(n))
+#else
+#define COUNT(c)		((void)0)
+#define COUNT_N(c,n)	((void)0)
+#endif
+
+// the counters of the calling thread, all 0 without _counters
+CounterSet& currentCounters();
+void mergeCounters(CounterSet& total,const CounterSet& x);	// safe between the OpenMP threads
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef elements_H
 #define elements_H
 #include <vector>
+#include <algorithm>
 #include "parameter.h"
 #include "frandom.h"
 using namespace std;
@@ -43,7 +44,6 @@ struct Edge
 	}
 };
 
-
 #endif
 struct Node
 {
@@ -104,14 +104,16 @@ struct Cluster
 {	
 	int N;
 	vector<float>B;
+	vector<int>Group;	// group of each VM, empty if the VDC has no group structure
 	float Arrivaltime;
 	float Holdtime;
 	Cluster(){}
 	Cluster(const Cluster& Rhs);//deep copy
-	void random();
-	void random(float load);
-	void random(int nVM,float minBw,float maxBw);
-	void random(int nVM1,int nVM2,float minBw,float maxBw);
+	void random(Random& rng);
+	void random(Random& rng,float load);
+	void random(Random& rng,float load,int n_server,int max_slot,int n_port);	// in a network of n_server servers
+	void random(Random& rng,int nVM,float minBw,float maxBw);
+	void random(Random& rng,int nVM1,int nVM2,float minBw,float maxBw);
 };
 //created bt luchukun
 //to define the ouversubscript
@@ -125,28 +127,138 @@ struct OversubscriptionCluster
 	float holdTime;
 	OversubscriptionCluster(){}
 	OversubscriptionCluster(const OversubscriptionCluster& rhs);//deep copy
-	void random();
+	void random(Random& rng);
 	//void randow(float load);
-	void random(int nGroup,float o,float minN,float maxN,float minBw,float maxBw);
+	void random(Random& rng,int nGroup,float o,float minN,float maxN,float minBw,float maxBw);
 };
 
-// to store the embedding solution
-class Solution 
+// to store the embedding solution, in the network of Topo. Slot and Bandwidth are read only,
+// the entries are written through setSlot/addSlot/setBandwidth, which record the servers and the
+// edges that become nonzero: Clear, the copies and SparseSolution::assign visit only those, the
+// footprint of the VDC rather than the whole network.
+template <class Topo>
+class SolutionT 
 {
 public:
-	float Departtime; 
-	int Slot[nServer];
-	float Bandwidth[Ne];      
-	Solution();
-	void Clear();
-	Solution(const Solution &Rhs);  
+	double Departtime; 
+	const int (&Slot)[Topo::nServer];
+	const float (&Bandwidth)[Topo::Ne];
+	SolutionT():Slot(slot),Bandwidth(bandwidth){zero();}
+	SolutionT(const SolutionT &Rhs):Slot(slot),Bandwidth(bandwidth){zero();*this=Rhs;}
+	void Clear()
+	{
+		Departtime=0;
+		for (int k=0;k<n_server_used;k++)
+		{	slot[server_used[k]]=0;
+			server_mark[server_used[k]]=false;
+		}
+		n_server_used=0;
+		clearBandwidth();
+	}
+	void clearBandwidth()
+	{
+		for (int k=0;k<n_edge_used;k++)
+		{	bandwidth[edge_used[k]]=0;
+			edge_mark[edge_used[k]]=false;
+		}
+		n_edge_used=0;
+	}
+	void setSlot(int i,int x){slot[i]=x;markServer(i);}
+	void addSlot(int i,int x){slot[i]+=x;markServer(i);}
+	void setBandwidth(int e,float x){bandwidth[e]=x;markEdge(e);}
+	void addBandwidth(int e,double x){bandwidth[e]+=x;markEdge(e);}
+	// the servers and the edges that were nonzero since the last Clear, in the order of their writes
+	int numOfServersUsed() const {return n_server_used;}
+	int serverUsed(int k) const {return server_used[k];}
+	int numOfEdgesUsed() const {return n_edge_used;}
+	int edgeUsed(int k) const {return edge_used[k];}
 
-	bool operator<( const Solution & Rhs ) const
+	bool operator<( const SolutionT & Rhs ) const
         { return Departtime< Rhs.Departtime; }
 	
-	const Solution& operator=( const Solution & Rhs );
+	const SolutionT& operator=( const SolutionT & Rhs )
+	{
+		if (this==&Rhs)
+			return *this;
+		Clear();
+		Departtime=Rhs.Departtime;
+		for (int k=0;k<Rhs.n_server_used;k++)
+			setSlot(Rhs.server_used[k],Rhs.slot[Rhs.server_used[k]]);
+		for (int k=0;k<Rhs.n_edge_used;k++)
+			setBandwidth(Rhs.edge_used[k],Rhs.bandwidth[Rhs.edge_used[k]]);
+		return *this;
+	}
+
+private:
+	int slot[Topo::nServer];
+	float bandwidth[Topo::Ne];
+	int n_server_used,n_edge_used;
+	int server_used[Topo::nServer],edge_used[Topo::Ne];
+	bool server_mark[Topo::nServer],edge_mark[Topo::Ne];
+	void zero()
+	{
+		Departtime=0;
+		for (int i=0;i<Topo::nServer;i++)
+		{	slot[i]=0;
+			server_mark[i]=false;
+		}
+		for (int e=0;e<Topo::Ne;e++)
+		{	bandwidth[e]=0;
+			edge_mark[e]=false;
+		}
+		n_server_used=n_edge_used=0;
+	}
+	void markServer(int i)
+	{
+		if (slot[i]!=0&&!server_mark[i])
+		{	server_mark[i]=true;
+			server_used[n_server_used++]=i;
+		}
+	}
+	void markEdge(int e)
+	{
+		if (bandwidth[e]!=0&&!edge_mark[e])
+		{	edge_mark[e]=true;
+			edge_used[n_edge_used++]=e;
+		}
+	}
 };
+typedef SolutionT<CompiledTopology> Solution;
 
+// the embedding solution of a VDC in the network: only the servers and the edges it uses
+class SparseSolution
+{
+public:
+	double Departtime;		// on the clock of the simulation, see RunState
+	vector<int> server,slot;	// slot[k] VMs on server[k]
+	vector<int> edge;			// bw[k] reserved on edge[k]
+	vector<float> bw;
+	SparseSolution():Departtime(0){}
+	// the nonzero entries of map, in the order of the servers and of the edges
+	template <class Topo> void assign(const SolutionT<Topo>& map)
+	{
+		Departtime=map.Departtime;
+		server.clear();slot.clear();edge.clear();bw.clear();
+		for (int k=0;k<map.numOfServersUsed();k++)
+			if (map.Slot[map.serverUsed(k)]!=0)
+				server.push_back(map.serverUsed(k));
+		sort(server.begin(),server.end());
+		for (size_t k=0;k<server.size();k++)
+			slot.push_back(map.Slot[server[k]]);
+		for (int k=0;k<map.numOfEdgesUsed();k++)
+			if (map.Bandwidth[map.edgeUsed(k)]!=0)
+				edge.push_back(map.edgeUsed(k));
+		sort(edge.begin(),edge.end());
+		for (size_t k=0;k<edge.size();k++)
+			bw.push_back(map.Bandwidth[edge[k]]);
+	}
+	template <class Archive> void save(Archive& ar) const
+	{	ar.put(Departtime);	ar.put(server);	ar.put(slot);	ar.put(edge);	ar.put(bw);}
+	template <class Archive> void load(Archive& ar)
+	{	ar.get(Departtime);	ar.get(server);	ar.get(slot);	ar.get(edge);	ar.get(bw);}
+	bool operator<( const SparseSolution & Rhs ) const
+        { return Departtime< Rhs.Departtime; }
+};
 
 struct Performance
 {
@@ -156,19 +268,5 @@ struct Performance
 	Performance(){}
 	void clear();
 };
-struct allocateRange
-{
-	//int ARs[maxN][maxSlot][maxSlot][nServer];
-	//int ARx[maxN][maxN][maxN][Nv-nServer];
-	bool ***p;
-	//int **split;
-	int n;
-	int a;
-	allocateRange(){}
-	void resize(int nVM,int nSlot);
-	bool& operator () (int x, int y, int i);
-	void release();
-	~allocateRange();
-};
 
 #endif
\ No newline at end of file
@@ -0,0 +1,288 @@
+#ifndef events_H
+#define events_H
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "elements.h"
+#include "binaryheaps.h"
+using namespace std;
+///////////////////////////////
+// discrete event core of the dynamic simulation: the departure queue holds small
+// (time,handle) entries, the sparse embedding results stay in a pool until the VDC departs
+
+//#define _calendar_queue	// calendar queue instead of the binary heap for the departures
+
+struct DepartEvent
+{
+	double time;	// departure time
+	int handle;		// the embedding of the VDC in the SolutionPool
+	DepartEvent(double t=0,int h=-1):time(t),handle(h){}
+	double key() const {return time;}
+	bool operator<(const DepartEvent& Rhs) const {return time<Rhs.time;}
+};
+
+// SparseSolution records reused through a free list, a handle stays valid until it is released
+class SolutionPool
+{
+public:
+	int acquire()
+	{
+		if (freeList.empty())
+		{	records.push_back(SparseSolution());
+			return (int)records.size()-1;
+		}
+		int h=freeList.back();
+		freeList.pop_back();
+		return h;
+	}
+	void release(int h){freeList.push_back(h);}
+	SparseSolution& operator[](int h){return records[h];}
+	int size() const {return (int)(records.size()-freeList.size());}
+	template <class Archive> void save(Archive& ar) const
+	{
+		ar.put((int)records.size());
+		for (size_t h=0;h<records.size();h++)
+			records[h].save(ar);
+		ar.put(freeList);
+	}
+	template <class Archive> void load(Archive& ar)
+	{
+		int n=0;
+		ar.get(n);
+		records.assign(max(n,0),SparseSolution());
+		for (size_t h=0;h<records.size();h++)
+			records[h].load(ar);
+		ar.get(freeList);
+	}
+
+private:
+	vector<SparseSolution> records;
+	vector<int> freeList;
+};
+
+// CalendarQueue class, same operations as BinaryHeap (R. Brown, CACM 1988)
+//
+// Type must provide key() and operator<. Bucket b holds the items of the days
+// floor(key/width)=b (mod nBucket), sorted in descending order so that the
+// earliest item is at the back. Insert and deleteMin are O(1) on average when
+// the items are spread evenly, e.g. exponentially distributed hold times.
+template <class Type>
+class CalendarQueue
+{
+public:
+	explicit CalendarQueue(int capacity);
+	bool isEmpty() const {return currentSize==0;}
+	const Type & findMin() const;
+
+	void insert(const Type & x);
+	Type deleteMin();
+	void deleteMin(Type & minItem);
+	void makeEmpty();
+	template <class Archive> void save(Archive& ar) const
+	{
+		ar.put(currentSize);	ar.put(width);	ar.put(today);	ar.put(minBucket);
+		ar.put((int)bucket.size());
+		for (size_t i=0;i<bucket.size();i++)
+			ar.put(bucket[i]);
+	}
+	template <class Archive> void load(Archive& ar)
+	{
+		int n=0;
+		ar.get(currentSize);	ar.get(width);	ar.get(today);	ar.get(minBucket);
+		ar.get(n);
+		bucket.assign(max(n,2),vector<Type>());
+		for (int i=0;i<n;i++)
+			ar.get(bucket[i]);
+	}
+
+private:
+	int currentSize;
+	vector<vector<Type> > bucket;
+	double width;			// length of a day
+	mutable double today;	// no item is earlier than today
+	mutable int minBucket;	// bucket of the min item, -1 if unknown
+
+	double dayOf(const Type & x) const {return floor(x.key()/width);}
+	int bucketOf(double day) const
+	{
+		double b=fmod(day,(double)bucket.size());
+		return (int)(b<0?b+bucket.size():b);
+	}
+	int locate() const;
+	void resize(int nBucket);
+};
+
+template <class Type>
+CalendarQueue<Type>::CalendarQueue(int capacity)
+{
+	currentSize=0;
+	width=1;	today=0;	minBucket=-1;
+	bucket.resize(max(2,capacity/2));
+}
+
+template <class Type>
+void CalendarQueue<Type>::insert(const Type & x)
+{
+	if (currentSize+1>2*(int)bucket.size())
+		resize(2*(int)bucket.size());
+	double day=dayOf(x);
+	if (currentSize==0||day<today)
+		today=day;
+	vector<Type>& b=bucket[bucketOf(day)];
+	// in front of the items with equal key, so that they leave first
+	int p=(int)b.size();
+	while (p>0&&!(x<b[p-1]))
+		p--;
+	b.insert(b.begin()+p,x);
+	currentSize++;
+	minBucket=-1;
+}
+
+// the bucket of the min item: scan the days of one year from today,
+// then fall back to a direct search over the earliest item of every bucket
+template <class Type>
+int CalendarQueue<Type>::locate() const
+{
+	if (minBucket>=0)
+		return minBucket;
+	int nBucket=(int)bucket.size();
+	for (int n=0;n<nBucket;n++,today++)
+	{
+		int i=bucketOf(today);
+		if (!bucket[i].empty()&&dayOf(bucket[i].back())<=today)
+			return minBucket=i;
+	}
+	int the_bucket=-1;
+	for (int i=0;i<nBucket;i++)
+		if (!bucket[i].empty()&&(the_bucket<0||bucket[i].back()<bucket[the_bucket].back()))
+			the_bucket=i;
+	today=dayOf(bucket[the_bucket].back());
+	return minBucket=the_bucket;
+}
+
+template <class Type>
+const Type & CalendarQueue<Type>::findMin() const
+{
+	if (isEmpty())
+	{	std::cout<<"The calendar queue is empty"<<endl;
+		static const Type none=Type();
+		return none;
+	}
+	return bucket[locate()].back();
+}
+
+template <class Type>
+Type CalendarQueue<Type>::deleteMin()
+{
+	Type minItem;
+	deleteMin(minItem);
+	return minItem;
+}
+
+template <class Type>
+void CalendarQueue<Type>::deleteMin(Type & minItem)
+{
+	if (isEmpty())
+	{	std::cout<<"The calendar queue is empty"<<endl;
+		return;
+	}
+	vector<Type>& b=bucket[locate()];
+	minItem=b.back();
+	b.pop_back();
+	currentSize--;
+	minBucket=-1;
+	if (bucket.size()>2&&currentSize<(int)bucket.size()/2)
+		resize((int)bucket.size()/2);
+}
+
+template <class Type>
+void CalendarQueue<Type>::makeEmpty()
+{
+	for (int i=0;i<(int)bucket.size();i++)
+		bucket[i].clear();
+	currentSize=0;
+	minBucket=-1;
+}
+
+// rebuild with nBucket buckets, a day is three times the mean gap between the earliest items
+template <class Type>
+void CalendarQueue<Type>::resize(int nBucket)
+{
+	vector<Type> items;
+	items.reserve(currentSize);
+	for (int i=0;i<(int)bucket.size();i++)
+		items.insert(items.end(),bucket[i].begin(),bucket[i].end());
+	int n_sample=min((int)items.size(),25);
+	if (n_sample>1)
+	{
+		partial_sort(items.begin(),items.begin()+n_sample,items.end());
+		double gap=(items[n_sample-1].key()-items[0].key())/(n_sample-1);
+		if (gap>0)
+			width=3*gap;
+	}
+	bucket.assign(nBucket,vector<Type>());
+	currentSize=0;
+	for (int k=0;k<(int)items.size();k++)
+		insert(items[k]);
+}
+
+#ifdef _calendar_queue
+typedef CalendarQueue<DepartEvent> DepartQueue;
+#else
+typedef BinaryHeap<DepartEvent> DepartQueue;
+#endif
+
+// the maximum of n values under point updates in O(log n), a tournament tree over the leaves.
+// NaN values are ignored, as by max
+class RunningMax
+{
+public:
+	RunningMax():n_leaf(0){}
+	void assign(int n)
+	{
+		for (n_leaf=1;n_leaf<n;n_leaf*=2)
+			;
+		node.assign(2*n_leaf,-HUGE_VALF);
+	}
+	void set(int i,float x)
+	{
+		int k=n_leaf+i;
+		node[k]=(x!=x)?-HUGE_VALF:x;
+		for (k/=2;k>=1;k/=2)
+			node[k]=std::max(node[2*k],node[2*k+1]);
+	}
+	float max() const {return node.empty()?-HUGE_VALF:node[1];}
+private:
+	int n_leaf;
+	vector<float> node;
+};
+
+// the state of a dynamic run (ProcessRequest) between two arrivals
+struct RunState
+{
+	double t;				// arrival time of the last request. a double, as the absolute times of
+							// long traces would round the hold times away in a float
+	int n_req,n_success;
+	float revenue,max_utilization,bandwidth_cost;	// sums over the admitted VDCs
+	SolutionPool pool;		// embedding results of the VDCs in the network
+	DepartQueue depart_list;
+	RunningMax utilization;	// of the edges, rebuilt from the network rather than checkpointed
+	explicit RunState(int capacity):t(0),n_req(0),n_success(0),revenue(0),max_utilization(0),bandwidth_cost(0),
+		depart_list(capacity){}
+	template <class Archive> void save(Archive& ar) const
+	{
+		ar.put(t);	ar.put(n_req);	ar.put(n_success);
+		ar.put(revenue);	ar.put(max_utilization);	ar.put(bandwidth_cost);
+		pool.save(ar);
+		depart_list.save(ar);
+	}
+	template <class Archive> void load(Archive& ar)
+	{
+		ar.get(t);	ar.get(n_req);	ar.get(n_success);
+		ar.get(revenue);	ar.get(max_utilization);	ar.get(bandwidth_cost);
+		pool.load(ar);
+		depart_list.load(ar);
+	}
+};
+
+#endif
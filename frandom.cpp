@@ -12,7 +12,7 @@
 #include "frandom.h"
 
 /* initializes mt[RD_N] with a seed */
-void init_genrand(unsigned long s)
+void Random::seed(unsigned long s)
 {
     mt[0]= s & 0xffffffffUL;
     for (mti=1; mti<RD_N; mti++) {
@@ -31,10 +31,10 @@ void init_genrand(unsigned long s)
 /* init_key is the array for initializing keys */
 /* key_length is its length */
 /* slight change for C++, 2004/2/26 */
-void init_by_array(unsigned long init_key[], int key_length)
+void Random::init_by_array(unsigned long init_key[], int key_length)
 {
     int i, j, k;
-    init_genrand(19650218UL);
+    seed(19650218UL);
     i=1; j=0;
     k = (RD_N>key_length ? RD_N : key_length);
     for (; k; k--) {
@@ -56,18 +56,25 @@ void init_by_array(unsigned long init_key[], int key_length)
     mt[0] = 0x80000000UL; /* MSB is 1; assuring non-zero initial array */ 
 }
 
+/* stream of a replication: initialized by the array {s,stream} */
+void Random::seed(unsigned long s,unsigned long stream)
+{
+    unsigned long init_key[2]={s,stream};
+    init_by_array(init_key,2);
+}
+
 /* generates a random number on [0,0xffffffff]-interval */
-unsigned long genrand_int32(void)
+unsigned long Random::genrand_int32(void)
 {
     unsigned long y;
-    static unsigned long mag01[2]={0x0UL, MATRIX_A};
+    const unsigned long mag01[2]={0x0UL, MATRIX_A};
     /* mag01[x] = x * MATRIX_A  for x=0,1 */
 
     if (mti >= RD_N) { /* generate RD_N words at one time */
         int kk;
 
         if (mti == RD_N+1)   /* if init_genrand() has not been called, */
-            init_genrand(5489UL); /* a default initial seed is used */
+            seed(5489UL); /* a default initial seed is used */
 
         for (kk=0;kk<RD_N-RD_M;kk++) {
             y = (mt[kk]&UPPER_MASK)|(mt[kk+1]&LOWER_MASK);
@@ -95,34 +102,34 @@ unsigned long genrand_int32(void)
 }
 
 /* generates a random number on [0,0x7fffffff]-interval */
-long genrand_int31(void)
+long Random::genrand_int31(void)
 {
     return (long)(genrand_int32()>>1);
 }
 
 /* generates a random number on [0,1]-real-interval */
-double genrand_real1(void)
+double Random::genrand_real1(void)
 {
     return genrand_int32()*(1.0/4294967295.0); 
     /* divided by 2^32-1 */ 
 }
 
 /* generates a random number on [0,1)-real-interval */
-double genrand_real2(void)
+double Random::genrand_real2(void)
 {
     return genrand_int32()*(1.0/4294967296.0); 
     /* divided by 2^32 */
 }
 
 /* generates a random number on (0,1)-real-interval */
-double genrand_real3(void)
+double Random::genrand_real3(void)
 {
     return (((double)genrand_int32()) + 0.5)*(1.0/4294967296.0); 
     /* divided by 2^32 */
 }
 
 /* generates a random number on [0,1) with 53-bit resolution*/
-double genrand_res53(void) 
+double Random::genrand_res53(void) 
 { 
     unsigned long a=genrand_int32()>>5, b=genrand_int32()>>6; 
     return(a*67108864.0+b)*(1.0/9007199254740992.0); 
@@ -130,7 +137,7 @@ double genrand_res53(void)
 /* These real versions are due to Isaku Wada, 2002/01/09 added */
 
 /* generates a random integer 1+[0,n-1] from [0,1)*/
-int unif_int(int n)
+int Random::unif_int(int n)
 {	
 	int i;
 	double f;
@@ -143,7 +150,7 @@ int unif_int(int n)
 	return i;
 }
 
-int unif_int(int x,int y)
+int Random::unif_int(int x,int y)
 {
 	int i;
 	double f;
@@ -155,14 +162,14 @@ int unif_int(int x,int y)
 	i=(int) (floor(f));
 	return i;
 }
-float unif_float(float x,float y)
+float Random::unif_float(float x,float y)
 {
 	float f=x+(y-x)*genrand_real1();
 	return f;
 }
 
 /* generate bip0=1-p,p1=p; from [0,1)*/
-bool rand_b01(float p)
+bool Random::rand_b01(float p)
 {
 	double f; 	
 	//init_genrand( (unsigned long)time( NULL ));
@@ -174,10 +181,26 @@ bool rand_b01(float p)
 		return 1;
 }	
 	
-float exprnd(float mean)
+float Random::exprnd(float mean)
 {
 	double f;
 	f=genrand_real3();
 	f=1/(1-f);
 	return (float) log(f)*mean;
 }
+
+/* the C interface uses one shared stream */
+Random defaultRandom;
+void init_genrand(unsigned long s){defaultRandom.seed(s);}
+void init_by_array(unsigned long init_key[], int key_length){defaultRandom.init_by_array(init_key,key_length);}
+unsigned long genrand_int32(void){return defaultRandom.genrand_int32();}
+long genrand_int31(void){return defaultRandom.genrand_int31();}
+double genrand_real1(void){return defaultRandom.genrand_real1();}
+double genrand_real2(void){return defaultRandom.genrand_real2();}
+double genrand_real3(void){return defaultRandom.genrand_real3();}
+double genrand_res53(void){return defaultRandom.genrand_res53();}
+int unif_int(int n){return defaultRandom.unif_int(n);}
+int unif_int(int x,int y){return defaultRandom.unif_int(x,y);}
+float unif_float(float x,float y){return defaultRandom.unif_float(x,y);}
+bool rand_b01(float p){return defaultRandom.rand_b01(p);}
+float exprnd(float mean){return defaultRandom.exprnd(mean);}
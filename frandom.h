@@ -15,12 +15,43 @@
 /* Period parameters */  
 const int RD_N=624;
 const int RD_M=397;
-const int MATRIX_A=0x9908b0dfUL;   /* constant vector a */
-const int UPPER_MASK=0x80000000UL; /* most significant w-r bits */
-const int LOWER_MASK=0x7fffffffUL;/* least significant r bits */
+const unsigned long MATRIX_A=0x9908b0dfUL;   /* constant vector a */
+const unsigned long UPPER_MASK=0x80000000UL; /* most significant w-r bits */
+const unsigned long LOWER_MASK=0x7fffffffUL;/* least significant r bits */
 
-static unsigned long mt[RD_N]; /* the array for the state vector  */
-static int mti=RD_N+1; /* mti==RD_N+1 means mt[RD_N] is not initialized */
+/* a MT19937 stream: the state belongs to the object, so that every run or */
+/* thread can own an independent, seed-addressable generator */
+class Random
+{
+public:
+    Random(){mti=RD_N+1;}
+    explicit Random(unsigned long s){seed(s);}
+    /* the same sequence as init_genrand(s) */
+    void seed(unsigned long s);
+    /* the stream-th independent stream of seed s, by init_by_array({s,stream}) */
+    void seed(unsigned long s,unsigned long stream);
+    void init_by_array(unsigned long init_key[], int key_length);
+    unsigned long genrand_int32(void);
+    long genrand_int31(void);
+    double genrand_real1(void);
+    double genrand_real2(void);
+    double genrand_real3(void);
+    double genrand_res53(void);
+    int unif_int(int n);
+    int unif_int(int x,int y);
+    float unif_float(float x,float y);
+    bool rand_b01(float p);
+    float exprnd(float mean);
+    /* the state, for the checkpoints */
+    template <class Archive> void save(Archive& ar) const {ar.put(mt,RD_N);ar.put(mti);}
+    template <class Archive> void load(Archive& ar) {ar.get(mt,RD_N);ar.get(mti);}
+
+private:
+    unsigned long mt[RD_N]; /* the array for the state vector  */
+    int mti; /* mti==RD_N+1 means mt[RD_N] is not initialized */
+};
+/* the stream behind the functions below */
+extern Random defaultRandom;
 
 /* initializes mt[RD_N] with a seed */
 void init_genrand(unsigned long s);
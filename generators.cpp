@@ -0,0 +1,242 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include "generators.h"
+using namespace std;
+
+const long long maxTopology=1<<28;	// nodes and links, the adjacency is indexed by int
+
+// creates the nodes, the servers first, or an empty topology if the sizes are invalid
+static bool create(Topology& topo,const char* name,bool valid,long long nServer,long long nSwitch,
+	long long nLink,int slot)
+{
+	if (!valid||nServer<=0||nSwitch<0||nServer+nSwitch>maxTopology||nLink>maxTopology)
+	{	cerr << "Bad parameters of the " << name << " topology\n";
+		topo.create(0);
+		topo.finish();
+		return false;
+	}
+	topo.create((int)(nServer+nSwitch));
+	for (int v=0;v<nServer;v++)
+		topo.setServer(v,slot);
+	topo.reserve((int)nLink);
+	return true;
+}
+
+bool generateFatTree(Topology& topo,int k,int slot,float bandwidth,float oversubscription)
+{
+	long long h=k/2;
+	long long nServer=k*h*h,nToR=k*h,nAggregate=k*h,nCore=h*h;
+	if (!create(topo,"fat-tree",k>=2&&k%2==0,nServer,nToR+nAggregate+nCore,3*nServer,slot))
+		return false;
+	int half=k/2,ToR=(int)nServer,Agg=ToR+(int)nToR,Core=Agg+(int)nAggregate;
+	float bw=bandwidth*oversubscription;
+	// servers to edge switches
+	for (int i=0;i<nToR;i++)
+		for (int j=0;j<half;j++)
+			topo.addLink(half*i+j,ToR+i,1,bw);
+	// edge to aggregation switches of the pod
+	for (int i=0;i<nToR;i++)
+		for (int j=0;j<half;j++)
+			topo.addLink(ToR+i,Agg+i/half*half+j,1,bw);
+	// cores to the aggregation switches of every pod
+	for (int i=0;i<nCore;i++)
+		for (int j=0;j<k;j++)
+			topo.addLink(Core+i,Agg+j*half+i/half,1,bw);
+	topo.finish();
+	return true;
+}
+
+bool generateVL2(Topology& topo,int DA,int DI,int serversPerToR,int slot,float serverBandwidth,
+	float oversubscription)
+{
+	long long nToR=(long long)DA*DI/4,nAggregate=DI,nIntermediate=DA/2;
+	long long nServer=nToR*serversPerToR;
+	bool valid=DA>=2&&DI>=2&&DA%2==0&&DI%2==0&&serversPerToR>0;
+	if (!create(topo,"VL2",valid,nServer,nToR+nAggregate+nIntermediate,
+		nServer+2*nToR+nAggregate*nIntermediate,slot))
+		return false;
+	int ToR=(int)nServer,Agg=ToR+(int)nToR,Int=Agg+(int)nAggregate;
+	float ToR2Agg=serverBandwidth*serversPerToR*oversubscription/2;
+	float Agg2Int=ToR2Agg*oversubscription;
+	for (int i=0;i<nToR;i++)
+		for (int j=0;j<serversPerToR;j++)
+			topo.addLink(serversPerToR*i+j,ToR+i,1,serverBandwidth);
+	// every ToR on the two aggregation switches of its group
+	for (int i=0;i<nToR;i++)
+	{
+		int group=i/(DA/2);
+		topo.addLink(ToR+i,Agg+group*2,1,ToR2Agg);
+		topo.addLink(ToR+i,Agg+group*2+1,1,ToR2Agg);
+	}
+	for (int i=0;i<nAggregate;i++)
+		for (int j=0;j<nIntermediate;j++)
+			topo.addLink(Agg+i,Int+j,1,Agg2Int);
+	topo.finish();
+	return true;
+}
+
+bool generateBCube(Topology& topo,int n,int k,int slot,float bandwidth)
+{
+	long long perLevel=1;	// n^k switches per level
+	for (int l=0;l<k&&perLevel<=maxTopology;l++)
+		perLevel*=n;
+	long long nServer=perLevel*n;
+	if (!create(topo,"BCube",n>=2&&k>=0&&perLevel<=maxTopology,nServer,(k+1)*perLevel,
+		(k+1)*nServer,slot))
+		return false;
+	int switch0=(int)nServer,m=(int)perLevel;
+	// level 0: a switch per rack
+	for (int s=0;s<m;s++)
+		for (int j=0;j<n;j++)
+			topo.addLink(s*n+j,switch0+s,1,bandwidth);
+	// level l: digit l of the server address is the port, in the order of drawBcube
+	int pow_l=1;	// n^l
+	for (int l=1;l<=k;l++)
+	{
+		pow_l*=n;
+		for (int j=0;j<n;j++)
+			for (int s=0;s<m;s++)
+			{
+				int server=(s/pow_l*n+j)*pow_l+s%pow_l;
+				topo.addLink(server,switch0+l*m+s,1,bandwidth);
+			}
+	}
+	topo.finish();
+	return true;
+}
+
+bool generateDCell(Topology& topo,int n,int k,int slot,float bandwidth)
+{
+	vector<long long> t(1,n);	// servers of a DCell_l
+	for (int l=1;l<=k&&t.back()<=maxTopology;l++)
+		t.push_back(t.back()*(t.back()+1));
+	long long nServer=t.back();
+	bool valid=n>=2&&k>=0&&nServer<=maxTopology;
+	if (!create(topo,"DCell",valid,nServer,nServer/n,nServer+(valid?nServer*k/2:0),slot))
+		return false;
+	int switch0=(int)nServer;
+	for (int c=0;c<nServer/n;c++)
+		for (int j=0;j<n;j++)
+			topo.addLink(c*n+j,switch0+c,1,bandwidth);
+	for (int l=1;l<=k;l++)
+	{
+		int size=(int)t[l],sub=(int)t[l-1],g=sub+1;
+		for (int base=0;base<nServer;base+=size)
+			for (int i=0;i<g;i++)
+				for (int j=i+1;j<g;j++)
+					topo.addLink(base+i*sub+j-1,base+j*sub+i,1,bandwidth);
+	}
+	topo.finish();
+	return true;
+}
+
+bool generateLeafSpine(Topology& topo,int nLeaf,int nSpine,int serversPerLeaf,int slot,
+	float serverBandwidth,float oversubscription)
+{
+	long long nServer=(long long)nLeaf*serversPerLeaf;
+	bool valid=nLeaf>0&&nSpine>0&&serversPerLeaf>0&&oversubscription>0;
+	if (!create(topo,"leaf-spine",valid,nServer,(long long)nLeaf+nSpine,
+		nServer+(long long)nLeaf*nSpine,slot))
+		return false;
+	int leaf=(int)nServer,spine=leaf+nLeaf;
+	float uplink=serversPerLeaf*serverBandwidth/(nSpine*oversubscription);
+	for (int i=0;i<nLeaf;i++)
+		for (int j=0;j<serversPerLeaf;j++)
+			topo.addLink(serversPerLeaf*i+j,leaf+i,1,serverBandwidth);
+	for (int i=0;i<nLeaf;i++)
+		for (int j=0;j<nSpine;j++)
+			topo.addLink(leaf+i,spine+j,1,uplink);
+	topo.finish();
+	return true;
+}
+
+// the switch graph of Jellyfish, open lists the switches with free ports
+class JellyfishGraph
+{
+public:
+	vector<int> x,y;	// the links, removed by swapping with the last one
+	vector<vector<int> > neighbor;
+	vector<int> free_ports,open,where;
+	JellyfishGraph(int nSwitch,int ports):neighbor(nSwitch),free_ports(nSwitch,ports),open(nSwitch),where(nSwitch)
+	{
+		for (int i=0;i<nSwitch;i++)
+			open[i]=where[i]=i;
+	}
+	bool linked(int a,int b) const
+	{
+		return find(neighbor[a].begin(),neighbor[a].end(),b)!=neighbor[a].end();
+	}
+	void add(int a,int b)
+	{
+		x.push_back(a);	y.push_back(b);
+		neighbor[a].push_back(b);	neighbor[b].push_back(a);
+		use(a);	use(b);
+	}
+	void remove(int l)
+	{
+		int a=x[l],b=y[l];
+		neighbor[a].erase(find(neighbor[a].begin(),neighbor[a].end(),b));
+		neighbor[b].erase(find(neighbor[b].begin(),neighbor[b].end(),a));
+		x[l]=x.back();	y[l]=y.back();
+		x.pop_back();	y.pop_back();
+		release(a);	release(b);
+	}
+private:
+	void use(int a)
+	{
+		if (--free_ports[a]==0)
+		{	int last=open.back();
+			open[where[a]]=last;	where[last]=where[a];
+			open.pop_back();
+		}
+	}
+	void release(int a)
+	{
+		if (free_ports[a]++==0)
+		{	where[a]=(int)open.size();
+			open.push_back(a);
+		}
+	}
+};
+
+bool generateJellyfish(Topology& topo,int nSwitch,int ports,int serversPerSwitch,int slot,
+	float serverBandwidth,float linkBandwidth,Random& rng)
+{
+	long long nServer=(long long)nSwitch*serversPerSwitch;
+	bool valid=nSwitch>1&&ports>0&&ports<nSwitch&&serversPerSwitch>0;
+	if (!create(topo,"Jellyfish",valid,nServer,nSwitch,nServer+(long long)nSwitch*ports/2,slot))
+		return false;
+	JellyfishGraph g(nSwitch,ports);
+	// pair random switches with free ports, until the tries fail many times in a row
+	for (int fails=0;g.open.size()>=2&&fails<100+10*(int)g.open.size();)
+	{
+		int a=g.open[rng.unif_int(0,(int)g.open.size()-1)];
+		int b=g.open[rng.unif_int(0,(int)g.open.size()-1)];
+		if (a==b||g.linked(a,b))
+		{	fails++;
+			continue;
+		}
+		g.add(a,b);
+		fails=0;
+	}
+	// a switch with two free ports or more replaces a random link (x,y) by (a,x) and (a,y)
+	for (int a=0;a<nSwitch;a++)
+		for (int tries=0;g.free_ports[a]>=2&&!g.x.empty()&&tries<1000;tries++)
+		{
+			int l=rng.unif_int(0,(int)g.x.size()-1);
+			int x=g.x[l],y=g.y[l];
+			if (x==a||y==a||g.linked(a,x)||g.linked(a,y))
+				continue;
+			g.remove(l);
+			g.add(a,x);	g.add(a,y);
+		}
+	int switch0=(int)nServer;
+	for (int i=0;i<nSwitch;i++)
+		for (int j=0;j<serversPerSwitch;j++)
+			topo.addLink(serversPerSwitch*i+j,switch0+i,1,serverBandwidth);
+	for (size_t l=0;l<g.x.size();l++)
+		topo.addLink(switch0+g.x[l],switch0+g.y[l],1,linkBandwidth);
+	topo.finish();
+	return true;
+}
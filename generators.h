@@ -0,0 +1,42 @@
+#ifndef generators_H
+#define generators_H
+#include "topology.h"
+#include "frandom.h"
+///////////////////////////////
+// data center topologies of any size, built at run time as a Topology (CSR), e.g. for the
+// scaling experiments or to be saved as binary files. the servers are the first nodes and get
+// slot VM slots each, the links cost 1. the compiled networks of parameter.h come out the same
+// as the draw functions of Graph: generateFatTree(t,H,...) as drawFattree, generateVL2(t,DA,DI,
+// nServerInRack,...) as drawVL2 and generateBCube(t,H,1,...) as drawBcube.
+// a generator returns false, with an empty topology, if its parameters are invalid.
+
+// k-ary fat-tree: k pods of k/2 edge and k/2 aggregation switches, (k/2)^2 cores, k^3/4 servers.
+// every link has bandwidth*oversubscription, as in drawFattree. k is even.
+bool generateFatTree(Topology& topo,int k,int slot,float bandwidth,float oversubscription=1);
+
+// VL2: DA*DI/4 ToRs of serversPerToR servers, DI aggregation switches of DA ports and DA/2
+// intermediate switches of DI ports. the ToR uplinks carry serverBandwidth*serversPerToR*
+// oversubscription/2, the aggregation uplinks that times oversubscription. DA and DI are even.
+bool generateVL2(Topology& topo,int DA,int DI,int serversPerToR,int slot,float serverBandwidth,
+	float oversubscription=1);
+
+// BCube(n,k): n^(k+1) servers with k+1 ports, k+1 levels of n^k switches with n ports.
+// the switch s of level l connects the servers whose addresses without digit l are s.
+bool generateBCube(Topology& topo,int n,int k,int slot,float bandwidth);
+
+// DCell(n,k): a DCell_0 is n servers on a switch, a DCell_l is t+1 DCell_(l-1) of t servers,
+// the server j-1 of sub-cell i linked to the server i of sub-cell j for i<j.
+bool generateDCell(Topology& topo,int n,int k,int slot,float bandwidth);
+
+// leaf-spine: every leaf is linked to every spine. oversubscription is the ratio of the server
+// bandwidth of a leaf to its uplink bandwidth, e.g. 3 for 3:1.
+bool generateLeafSpine(Topology& topo,int nLeaf,int nSpine,int serversPerLeaf,int slot,
+	float serverBandwidth,float oversubscription=1);
+
+// Jellyfish: a random regular graph of nSwitch switches with ports switch-to-switch ports each,
+// and serversPerSwitch servers per switch. the switches are paired at random; a switch left with
+// two free ports or more breaks a random link (x,y) and is linked to x and y instead.
+bool generateJellyfish(Topology& topo,int nSwitch,int ports,int serversPerSwitch,int slot,
+	float serverBandwidth,float linkBandwidth,Random& rng);
+
+#endif
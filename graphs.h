@@ -13,6 +13,18 @@
 #include <ctime>
 #include "binaryheaps.h"
 #include "elements.h"
+#include "bitsets.h"
+#include "events.h"
+#include "trace.h"
+#include "reqlog.h"
+#include "steady.h"
+#include "checkpoint.h"
+#include "timer.h"
+#include "latency.h"
+#include "counters.h"
+#include "mincostflow.h"
+#include "workspace.h"
+#include "topology.h"
 #include "parameter.h"
 
 using namespace std;
@@ -23,9 +35,49 @@ using namespace std;
 //#define _cut_check
 //#define _BottleckXHostBw
 #define _newBottleckCriteria
+#define _native_VC_ACE
+//#define _native_LPmaxTraffic	// the max traffic LP of an edge as a min cost flow instead of CPLEX
+#ifdef _no_cplex
+#define _native_VC_ACE
+#define _native_LPmaxTraffic
+#endif
+// the assignment of a placement, in the arena of the workspace
+typedef ArenaVector<int>::type Assignment;	// the server of each VM, -1 if not placed
 ///////////////////////////////
-class Graph
+// the engine of the network of Topo (see parameter.h), Graph is the one of the compiled topology.
+// the sizes of Topo shadow the global ones in the members, so that engines of several fabrics
+// can live in one process, e.g. for the sweeps over topologies (sweep.h)
+template <class Topo>
+class GraphT
 {
+public:
+	typedef GraphT Graph;
+	typedef SolutionT<Topo> Solution;
+	typedef ServerSetT<Topo> ServerSet;
+	typedef CandidateServersT<Topo> CandidateServers;
+	typedef WorkspaceT<Topo> Workspace;
+	typedef WorkFrameT<Topo> WorkFrame;
+	typedef EdgeMarksT<Topo> EdgeMarks;
+	static const int H=Topo::H;
+	static const int DA=Topo::DA;
+	static const int DI=Topo::DI;
+	static const int nIntermediate=Topo::nIntermediate;
+	static const int nCore=Topo::nCore;
+	static const int nEdge=Topo::nEdge;
+	static const int nEdgePort=Topo::nEdgePort;
+	static const int nServer=Topo::nServer;
+	static const int Nv=Topo::Nv;
+	static const int Ne=Topo::Ne;
+	static const int nPair=nServer*(nServer-1);
+	static const int nToR=Topo::nToR;
+	static const int nAggregate=Topo::nAggregate;
+	static const int nServerInRack=Topo::nServerInRack;
+	static const int nSwitch=Topo::nSwitch;
+	static const int maxDegree=Topo::maxDegree;
+	static const int n_server_port=Topo::n_server_port;
+	static const int Kspt=Topo::Kspt;
+	static const int Kwidest=Topo::Kwidest;
+	static const int maxSlot=Topo::maxSlot;
 private:
 	Node Table[Nv];//store the index of its Adj
 	float resBandwidth[Ne];
@@ -37,6 +89,12 @@ private:
 	int opposite[Ne];
 	int costMatrix[nServer][nServer];
 	vector<vector<int>> serverCluster;// 
+	Workspace workspace;	// scratch memory of the placement algorithms, reused by the requests
+	// the routing kernels of a pair, K is Kmax, 0 for any Kmax
+	int pathCapacities(int s,int d,float* capacity);
+	float splitRouting(int s,int d,int n,const bool* selected,const float* split_ratio);
+	template <int K> float loadBalance(int s,int d);
+	template <int K> float ecmp(int s,int d);
 	
 public:
 	
@@ -44,8 +102,9 @@ public:
 	T_Routing routingOption;
 	unsigned short Kpaths[nServer][nServer][Kspt][Nv+1];//Kpaths[][][][0]洢·
 	unsigned short n_path[nServer][nServer];
-	Graph();
-	~Graph();
+	bool routesReady;	// Kpaths and n_path hold the paths of the current topology
+	GraphT();
+	~GraphT();
 	void printCostMatrix();
 	void printserverCluster();
 	void drawVL2();
@@ -53,18 +112,43 @@ public:
 	void drawFattree();
 	void drawBcube();
 	void drawL2VL2();
+	void draw();	// the network of the family of Topo
 	void AddEdge(const int & s, const int & d, const float &cost,const float &bandw,const int&addr);
 	int drawGragh(string &file_name);
+	int drawTopology(const Topology& topo);
 	void ClearTable();
 	void ClearNetwork();
-	void RandomNetwork(float p,float p_minResBw,float p_maxResBw);
+	Random rng;		// random stream of the runs
+	int stream;		// -1: every run starts from seed 0, else from stream "stream" of seed 0
+	void seedRun(){if(stream<0) rng.seed(0); else rng.seed(0,stream);}
+	RequestLog* requestLog;	// per-request records of ProcessRequest, none if 0
+	SteadyState* steadyState;	// steady state estimates and early stop of ProcessRequest, numOfreq is the limit
+	Checkpoint* checkpoint;		// snapshots and resume of ProcessRequest, none if 0
+	PhaseProfile* profile;		// latency histograms of the embedding phases, none if 0
+	// residual slots and bandwidths, for the checkpoints
+	template <class Archive> void saveNetwork(Archive& ar) const
+	{	for (int i=0;i<nServer;i++)
+			ar.put(Table[i].Slot);
+		ar.put(resBandwidth,Ne);
+	}
+	template <class Archive> void loadNetwork(Archive& ar)
+	{	for (int i=0;i<nServer;i++)
+			ar.get(Table[i].Slot);
+		ar.get(resBandwidth,Ne);
+	}
+	int n_trial;		// congestion checks of the current request
+	void RandomNetwork(Random& rng,float p,float p_minResBw,float p_maxResBw);
 	void PrintPathRec(int DestNode) const;
 	void PrintPath(int s,int d) const;
 	void reserveResource(const Solution &map);
 	void releaseResource(const Solution &map);
+	void reserveResource(const SparseSolution &vdc);
+	void releaseResource(const SparseSolution &vdc);
 
 	float ProcessRequest(char algorithm,bool enLProuting,int numOfreq,float load,
 						float &max_utilization,float &success_rate,float &bandwidth_cost,float &RC);
+	float ProcessRequest(char algorithm,bool enLProuting,RequestSource& source,int numOfreq,
+						float &max_utilization,float &success_rate,float &bandwidth_cost,float &RC);
 	float SingleRequest(char algorithm,bool enLProuting,int numOfreq,
 			float p,float p_minResBw,float p_maxResBw,int numberOfGroup,int min_numberOfVM, int max_numberOfVM,float minBw,float maxBw,
 			float& max_utilization,float& success_rate,float& bandwidth_cost);
@@ -80,8 +164,16 @@ public:
 	float Dijkstra(int s, int d);
 	bool calCostMatrix(int numberofCluster,int numberofVm);
 	void YenKSP(int s,int d);	
+	void computeRoutes();
+	void copyRoutes(const Graph& master);
 	float LoadBalance(int s,int d);
 	float ECMP(int s,int d);
+	// LoadBalance and ECMP specialized on Kmax (1, 2, 4 or 8), chosen once before the loops over
+	// the pairs
+	typedef float (Graph::*RoutingKernel)(int s,int d);
+	RoutingKernel loadBalanceKernel() const;
+	RoutingKernel ECMPKernel() const;
+	RoutingKernel routingKernel() const;	// the kernel of routingOption, 0 if none
 	float MaxFlowRouting(int s,int d);
 	int Sort_fsd(int e);//return the number of pairs that passes e[i][j]
 	float maxTraffic(int e,float* hostBw);
@@ -94,22 +186,23 @@ public:
 	float CalcMaxLinkUt(const Cluster& req,float* hostBw,Solution&map);//dual LP
 	float assignBandwidth(Cluster& req,float* hostBw,Solution& map);//|E|*min_cost_flow LP
 	float LPmaxTraffic(int e,float* hostBw);
-	float LPmaxTrafficUnderValidtraffic(OversubscriptionCluster& req,int e,float * hostBw,vector<int>& assignment);
+	float maxTrafficFlow(int e,const float* hostBw,const float* TS_max,const float* TD_max);
+	float LPmaxTrafficUnderValidtraffic(OversubscriptionCluster& req,int e,float * hostBw,Assignment& assignment);
 	float LPRouting(const Cluster& req,float* hostBw,Solution&map);//LP and calc map.bandwidth
 	float OptimalRouting(const Cluster& req,float* hostBw,Solution&map);//LP
 	bool QuickFail(Cluster& req,Solution&map,float(*sum_capacity)[nServer],float& sumB,float* res_port_B);
 #ifdef _cut_check
 	bool CutCheck(const Cluster& req,float& sumB,float* hostBw);
 #endif
-	bool oversubscribedCongestDetect(int x,OversubscriptionCluster& req,float* hostBw,float (*sum_capacity)[nServer],Solution& map,vector<int>& assignment);
-	bool oversubscribedVmpalcement(OversubscriptionCluster& req,Solution& map,int maxLoop,vector<int>& assignment);
-	bool GroupAllocate(bool enLProuting,vector<int>& servercluster,OversubscriptionCluster& req,Solution& map,vector<int>& groupassignment,float (*sum_capacity)[nServer]);
+	bool oversubscribedCongestDetect(int x,OversubscriptionCluster& req,float* hostBw,float (*sum_capacity)[nServer],Solution& map,Assignment& assignment);
+	bool oversubscribedVmpalcement(OversubscriptionCluster& req,Solution& map,int maxLoop,Assignment& assignment);
+	bool GroupAllocate(bool enLProuting,vector<int>& servercluster,OversubscriptionCluster& req,Solution& map,Assignment& groupassignment,float (*sum_capacity)[nServer]);
 	// the embedding algorithm
 	bool oversubscribedQuickFail(OversubscriptionCluster& req,Solution&map,float(*sum_capacity)[nServer],float& sumB,float* res_port_B);
 	bool Pertubation(Cluster &req,bool enLProuting,Solution &map);
 	bool oversubscribedFirstFit(OversubscriptionCluster &req, Solution &map);
-	bool oversusbcribedVmpalcement(OversubscriptionCluster& req,Solution&map,int maxLoop,vector<int>& assignment);
-	bool PertubationVmplacement(OversubscriptionCluster& req,Solution&,int maxpertubation,vector<int>& assignment);
+	bool oversusbcribedVmpalcement(OversubscriptionCluster& req,Solution&map,int maxLoop,Assignment& assignment);
+	bool PertubationVmplacement(OversubscriptionCluster& req,Solution&,int maxpertubation,Assignment& assignment);
 	void findserver(int& thelink,int& serverfrom,int&serverto,Solution &map,float * hostBw);
 	bool randomDrop(Cluster &req,bool enLProuting,Solution &map);
 	bool LocalSearch(Cluster& req,bool enLProuting,Solution& map);
@@ -117,10 +210,10 @@ public:
 	bool NextFit(Cluster &req,bool enLProuting,Solution &map);
 	bool BestFit(Cluster &req,bool enLProuting,Solution &map);
 
-	bool recursivePlacement(Cluster &req,bool enLProuting,int max_backtrack,int &n_backtrack,Solution &map,vector<int>& assignment,
+	bool recursivePlacement(Cluster &req,bool enLProuting,int max_backtrack,int &n_backtrack,Solution &map,Assignment& assignment,CandidateServers& cand,
 		float sumB,float* res_port_B,float (*sum_capacity)[nServer],float* hostBw,int &numVMembedded);
 	bool BackTracking(Cluster &req,bool enLProuting,Solution &map);
-	bool recursivePlacement(Cluster &req,bool enLProuting,Solution &map,vector<int>& assignment,
+	bool recursivePlacement(Cluster &req,bool enLProuting,Solution &map,Assignment& assignment,CandidateServers& cand,
 		float sumB,float* res_port_B,float (*sum_capacity)[nServer],float* hostBw,int &numVMembedded);
 	float VC_ACE(int N,float B,int star, float cost_factor,Solution &map);
 	bool HVC_ACE(Cluster &req,Solution &map);
@@ -136,10 +229,40 @@ public:
 
 #ifdef _enumeration
 	bool ExhaustiveSearch(Cluster &req,bool enLProuting, Solution &map);
-	bool Enumeration(Cluster &req, Solution &map,vector<int>& assignment,float sumB,float* res_port_B,
+	bool Enumeration(Cluster &req, Solution &map,Assignment& assignment,float sumB,float* res_port_B,
 							   float* hostBw,int &numVMembedded);
 #endif	
 };
+template <class Topo> const int GraphT<Topo>::H;
+template <class Topo> const int GraphT<Topo>::DA;
+template <class Topo> const int GraphT<Topo>::DI;
+template <class Topo> const int GraphT<Topo>::nIntermediate;
+template <class Topo> const int GraphT<Topo>::nCore;
+template <class Topo> const int GraphT<Topo>::nEdge;
+template <class Topo> const int GraphT<Topo>::nEdgePort;
+template <class Topo> const int GraphT<Topo>::nServer;
+template <class Topo> const int GraphT<Topo>::Nv;
+template <class Topo> const int GraphT<Topo>::Ne;
+template <class Topo> const int GraphT<Topo>::nPair;
+template <class Topo> const int GraphT<Topo>::nToR;
+template <class Topo> const int GraphT<Topo>::nAggregate;
+template <class Topo> const int GraphT<Topo>::nServerInRack;
+template <class Topo> const int GraphT<Topo>::nSwitch;
+template <class Topo> const int GraphT<Topo>::maxDegree;
+template <class Topo> const int GraphT<Topo>::n_server_port;
+template <class Topo> const int GraphT<Topo>::Kspt;
+template <class Topo> const int GraphT<Topo>::Kwidest;
+template <class Topo> const int GraphT<Topo>::maxSlot;
+
+typedef GraphT<CompiledTopology> Graph;
 
+// the engines compiled besides Graph, instantiated in graphs.cpp: X(traits of parameter.h)
+#define GRAPH_TOPOLOGIES(X) X(VL2_4x4) X(VL2_8x4) X(FatTree_H4) X(FatTree_H6) X(Bcube_H4)
+
+template <class Topo>
+struct EngineTopology<GraphT<Topo> >
+{
+	typedef Topo type;
+};
 
 #endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <algorithm>
+#include "latency.h"
+using namespace std;
+
+const float minLatency=1.0f/64;	// us, the lower edge of bucket 1
+
+void LatencyHistogram::clear()
+{
+	for (int b=0;b<nBucket;b++)
+		bucket[b]=0;
+	n=0;
+	sum=0;
+	maxValue=0;
+}
+
+// octave e and linear sub-bucket of the mantissa, as in HDR histograms
+int LatencyHistogram::index(float us)
+{
+	if (!(us>=minLatency))
+		return 0;
+	int e;
+	double m=frexp(us/minLatency,&e);	// us/minLatency=m*2^e, m in [0.5,1)
+	int b=(e-1)*nSub+(int)((2*m-1)*nSub)+1;
+	return min(b,nBucket-1);
+}
+
+float LatencyHistogram::upperEdge(int b)
+{
+	if (b==0)
+		return minLatency;
+	int e=(b-1)/nSub,sub=(b-1)%nSub;
+	return (float)ldexp(minLatency*(1+(sub+1)/(double)nSub),e);
+}
+
+void LatencyHistogram::add(float us)
+{
+	bucket[index(us)]++;
+	n++;
+	sum+=us;
+	maxValue=std::max(maxValue,us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& h)
+{
+	for (int b=0;b<nBucket;b++)
+		bucket[b]+=h.bucket[b];
+	n+=h.n;
+	sum+=h.sum;
+	maxValue=std::max(maxValue,h.maxValue);
+}
+
+float LatencyHistogram::quantile(float p) const
+{
+	if (n==0)
+		return 0;
+	int rank=(int)ceil(p*n),seen=0;
+	rank=std::max(rank,1);
+	for (int b=0;b<nBucket;b++)
+	{
+		seen+=bucket[b];
+		if (seen>=rank)
+			return std::min(upperEdge(b),maxValue);
+	}
+	return maxValue;
+}
+
+void PhaseProfile::clear()
+{
+	for (int k=0;k<nPhase;k++)
+	{	histogram[k].clear();
+		current[k]=0;
+	}
+	start=0;
+}
+
+void PhaseProfile::merge(const PhaseProfile& p)
+{
+	for (int k=0;k<nPhase;k++)
+		histogram[k].merge(p.histogram[k]);
+}
+
+void PhaseProfile::begin()
+{
+	for (int k=0;k<nPhase;k++)
+		current[k]=0;
+	start=monotonicTime();
+}
+
+void PhaseProfile::end(double placement)
+{
+	current[TOTAL]=monotonicTime()-start;
+	current[SEARCH]=max(placement-current[QUICKFAIL]-current[CONGEST],0.0);
+	for (int k=0;k<nPhase;k++)
+		histogram[k].add((float)(1e6*current[k]));
+}
+
+const char* PhaseProfile::name(int phase)
+{
+	const char* names[nPhase]={"release","quickfail","search","congest","lp","commit","total"};
+	return names[phase];
+}
+
+void PhaseProfile::write(ostream& out,const char* label) const
+{
+	for (int k=0;k<nPhase;k++)
+	{
+		const LatencyHistogram& h=histogram[k];
+		out<<label<<" "<<name(k)<<" "<<h.count()<<" "<<h.mean()<<" "<<h.quantile(0.5f)<<" "
+			<<h.quantile(0.9f)<<" "<<h.quantile(0.99f)<<" "<<h.max()<<"\n";
+	}
+}
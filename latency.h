@@ -0,0 +1,91 @@
+#ifndef latency_H
+#define latency_H
+#include <iostream>
+#include "timer.h"
+using namespace std;
+///////////////////////////////
+// latency histograms of the embedding phases.
+//
+// LatencyHistogram: log buckets of 1/8 octave from 1/64 us (about 9% relative error),
+// the quantiles are the upper edges of their buckets.
+// PhaseProfile: one histogram per phase, a sample per request. the spans of a request
+// are summed, e.g. all the CongestDetect calls of a placement, and added at its end.
+//	release		departures processed before the arrival (ProcessRequest)
+//	quickfail	QuickFail
+//	search		placement - quickfail - congest, the candidate search
+//	congest		CongestDetect, includes the lp solves made by it
+//	lp			LP/max-flow routing and max traffic solves
+//	commit		reserve the resources and queue the departure (ProcessRequest)
+//	total		the request, release to commit
+
+class LatencyHistogram
+{
+public:
+	LatencyHistogram(){clear();}
+	void clear();
+	void add(float us);
+	void merge(const LatencyHistogram& h);
+	int count() const {return n;}
+	float mean() const {return n>0?(float)(sum/n):0;}
+	float max() const {return maxValue;}
+	float quantile(float p) const;	// p in [0,1]
+	// the buckets, e.g. for the result files: bucket b holds the samples up to bucketEdge(b) us
+	// and above bucketEdge(b-1)
+	static int numOfBuckets(){return nBucket;}
+	static float bucketEdge(int b){return upperEdge(b);}
+	int bucketCount(int b) const {return bucket[b];}
+
+private:
+	enum{nSub=8,nOctave=40,nBucket=nSub*nOctave+1};
+	int bucket[nBucket];	// bucket 0: below 1/64 us
+	int n;
+	double sum;
+	float maxValue;
+	static int index(float us);
+	static float upperEdge(int b);
+};
+
+class PhaseProfile
+{
+public:
+	enum Phase{RELEASE,QUICKFAIL,SEARCH,CONGEST,LP,COMMIT,TOTAL,nPhase};
+	LatencyHistogram histogram[nPhase];
+	double current[nPhase];		// seconds spent in the phases by the current request
+
+	PhaseProfile(){clear();}
+	void clear();
+	void merge(const PhaseProfile& p);
+	void begin();					// a new request
+	void end(double placement);		// the request is done, placement: seconds of the placement algorithm
+	static const char* name(int phase);
+	// one line per phase: label phase count mean p50 p90 p99 max (us)
+	void write(ostream& out,const char* label) const;
+
+private:
+	double start;
+};
+
+// adds the time from its construction to stop() or its destruction to a phase, nothing if profile is 0
+class PhaseSpan
+{
+public:
+	PhaseSpan(PhaseProfile* profile,int phase):profile(profile),phase(phase)
+	{
+		if (profile)
+			t0=monotonicTime();
+	}
+	~PhaseSpan(){stop();}
+	void stop()
+	{
+		if (profile)
+		{	profile->current[phase]+=monotonicTime()-t0;
+			profile=0;
+		}
+	}
+private:
+	PhaseProfile* profile;
+	int phase;
+	double t0;
+};
+
+#endif
@@ -20,12 +20,22 @@
 #define _MATRIX_H_
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <algorithm>
-
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+// the move constructors and assignments need rvalue references: VS2010, or C++11 elsewhere
+#if defined(_MSC_VER) ? _MSC_VER>=1600 : __cplusplus>=201103L
+#define _matrix_move
+#endif
+
+// the elements are stored row by row in one buffer, a row takes stride() elements.
+// the stride is rounded up to 16 bytes, so the loops over a row are vectorized.
+// Matrix<bool> packs the elements into bits, see below.
 template <class T>
 class Matrix {
 public:
-	T **m_matrix;
 	int m_rows;
 	int m_columns;
 public:
@@ -33,15 +43,30 @@ public:
 	Matrix(int rows, int columns);
 	Matrix(const Matrix<T> &other);
 	Matrix<T> & operator= (const Matrix<T> &other);
+#ifdef _matrix_move
+	Matrix(Matrix<T> &&other);
+	Matrix<T> & operator= (Matrix<T> &&other);
+#endif
 	~Matrix();
 	// all operations except product modify the matrix in-place.
 	void resize(int rows, int columns);
 	void identity(void);
 	void clear(void);
 	T& operator () (int x, int y);
+	const T& operator () (int x, int y) const;
+	// the m_columns elements of row x
+	T* row(int x) {
+		return m_data + (size_t)x * m_stride;
+	}
+	const T* row(int x) const {
+		return m_data + (size_t)x * m_stride;
+	}
+	int stride(void) const {
+		return m_stride;
+	}
 	T trace(void);
 	Matrix<T>& transpose(void);
-	Matrix<T> product(Matrix<T> &other);
+	Matrix<T> product(const Matrix<T> &other) const;
 	int minsize(void) {
 		return ((m_rows < m_columns) ? m_rows : m_columns);
 	}
@@ -52,6 +77,19 @@ public:
 		return m_rows;
 	}
 
+private:
+	T *m_data;
+	int m_stride;
+	static int strideOf(int columns) {
+		const int n = sizeof(T) < 16 ? 16 / sizeof(T) : 1;
+		return (columns + n - 1) / n * n;
+	}
+	void swap(Matrix<T> &other) {
+		std::swap(m_data, other.m_data);
+		std::swap(m_rows, other.m_rows);
+		std::swap(m_columns, other.m_columns);
+		std::swap(m_stride, other.m_stride);
+	}
 };
 
 template <class T>
@@ -59,196 +97,172 @@ Matrix<T>::Matrix()
 {
 	m_rows = 0;
 	m_columns = 0;
-	m_matrix = NULL;
+	m_stride = 0;
+	m_data = NULL;
 }
 
 template <class T>
 Matrix<T>::Matrix(const Matrix<T> &other) 
 {
-	if ( other.m_matrix != NULL ) {
-		// copy arrays
-		m_matrix = NULL;
-		resize(other.m_rows, other.m_columns);
-		for ( int i = 0 ; i < m_rows ; i++ )
-			for ( int j = 0 ; j < m_columns ; j++ )
-				m_matrix[i][j] = other.m_matrix[i][j];
-	} else {
-		m_matrix = NULL;
-		m_rows = 0;
-		m_columns = 0;
+	m_rows = other.m_rows;
+	m_columns = other.m_columns;
+	m_stride = other.m_stride;
+	m_data = NULL;
+	if ( other.m_data != NULL ) {
+		size_t n = (size_t)m_rows * m_stride;
+		m_data = new T[n];
+		std::copy(other.m_data, other.m_data + n, m_data);
 	}
 }
 
+#ifdef _matrix_move
+template <class T>
+Matrix<T>::Matrix(Matrix<T> &&other) 
+{
+	m_rows = 0;
+	m_columns = 0;
+	m_stride = 0;
+	m_data = NULL;
+	swap(other);
+}
+#endif
+
 template <class T>
 Matrix<T>::Matrix(int rows, int columns) 
 {
-	m_matrix = NULL;
+	m_rows = 0;
+	m_columns = 0;
+	m_stride = 0;
+	m_data = NULL;
 	resize(rows, columns);
 }
 
 template <class T>
 Matrix<T> &Matrix<T>::operator= (const Matrix<T> &other) 
 {
-	if ( other.m_matrix != NULL ) {
-		// copy arrays
-		resize(other.m_rows, other.m_columns);
-		for ( int i = 0 ; i < m_rows ; i++ )
-			for ( int j = 0 ; j < m_columns ; j++ )
-				m_matrix[i][j] = other.m_matrix[i][j];
-	} else {
-		// free arrays
-		for ( int i = 0 ; i < m_columns ; i++ )
-			delete [] m_matrix[i];
-
-		delete [] m_matrix;
-
-		m_matrix = NULL;
-		m_rows = 0;
-		m_columns = 0;
-	}
-	
+	if ( this != &other ) {
+		Matrix<T> copy(other);
+		swap(copy);
+	}
 	return *this;
 }
 
+#ifdef _matrix_move
 template <class T>
-Matrix<T>::~Matrix() 
+Matrix<T> &Matrix<T>::operator= (Matrix<T> &&other) 
 {
-	if ( m_matrix != NULL ) {
-		// free arrays
-		for ( int i = 0 ; i < m_rows ; i++ )
-			delete [] m_matrix[i];
+	swap(other);
+	return *this;
+}
+#endif
 
-		delete [] m_matrix;
-	}
-	m_matrix = NULL;
+template <class T>
+Matrix<T>::~Matrix() 
+{
+	delete [] m_data;
+	m_data = NULL;
 }
 
 
 
+// keeps the elements of the common rows and columns, the others are zero
 template <class T>
 void Matrix<T>::resize(int rows, int columns) 
 {
-	if ( m_matrix == NULL ) {
-		// alloc arrays
-		m_matrix = new T*[rows]; // rows
-		for ( int i = 0 ; i < rows ; i++ )
-			m_matrix[i] = new T[columns]; // columns
-
-		m_rows = rows;
-		m_columns = columns;
-		clear();
-	} else {
-		// save array pointer
-		T **new_matrix;
-		// alloc new arrays
-		new_matrix = new T*[rows]; // rows
-		for ( int i = 0 ; i < rows ; i++ ) {
-			new_matrix[i] = new T[columns]; // columns
-			for ( int j = 0 ; j < columns ; j++ )
-				new_matrix[i][j] = 0;
-		}
-
-		// copy data from saved pointer to new arrays
-		int minrows = std::min<int>(rows, m_rows);
-		int mincols = std::min<int>(columns, m_columns);
-		for ( int x = 0 ; x < minrows ; x++ )
-			for ( int y = 0 ; y < mincols ; y++ )
-				new_matrix[x][y] = m_matrix[x][y];
-
-		// delete old arrays
-		if ( m_matrix != NULL ) {
-			for ( int i = 0 ; i < m_rows ; i++ )
-				delete [] m_matrix[i];
-
-			delete [] m_matrix;
-		}
-
-		m_matrix = new_matrix;
-	}
-
-	m_rows = rows;
-	m_columns = columns;
+	if ( m_data != NULL && rows == m_rows && columns == m_columns )
+		return;
+	Matrix<T> m;
+	m.m_rows = rows;
+	m.m_columns = columns;
+	m.m_stride = strideOf(columns);
+	m.m_data = new T[(size_t)rows * m.m_stride];
+	m.clear();
+
+	// copy data from the old buffer
+	int minrows = std::min<int>(rows, m_rows);
+	int mincols = std::min<int>(columns, m_columns);
+	for ( int x = 0 ; x < minrows ; x++ )
+		std::copy(row(x), row(x) + mincols, m.row(x));
+
+	swap(m);
 }
 
 template <class T>
 void Matrix<T>::identity() 
 {
-	assert( m_matrix != NULL );
+	assert( m_data != NULL );
 
 	clear();
 
 	int x = std::min<int>(m_rows, m_columns);
 	for ( int i = 0 ; i < x ; i++ )
-		m_matrix[i][i] = 1;
+		(*this)(i,i) = 1;
 }
 
 template <class T>
 void Matrix<T>::clear() 
 {
-	assert( m_matrix != NULL );
+	assert( m_data != NULL );
 
-	for ( int i = 0 ; i < m_rows ; i++ )
-		for ( int j = 0 ; j < m_columns ; j++ )
-			m_matrix[i][j] = 0;
+	std::fill(m_data, m_data + (size_t)m_rows * m_stride, T(0));
 }
 
 template <class T>
 T Matrix<T>::trace() 
 {
-	assert( m_matrix != NULL );
+	assert( m_data != NULL );
 
 	T value = 0;
 
 	int x = std::min<int>(m_rows, m_columns);
 	for ( int i = 0 ; i < x ; i++ )
-		value += m_matrix[i][i];
+		value += (*this)(i,i);
 
 	return value;
 }
 
+// into a new buffer, by blocks that stay in the cache
 template <class T>
 Matrix<T>& Matrix<T>::transpose() {
 	assert( m_rows > 0 );
 	assert( m_columns > 0 );
 
-	int new_rows = m_columns;
-	int new_columns = m_rows;
-
-	if ( m_rows != m_columns ) {
-		// expand matrix
-		int m = std::max<int>(m_rows, m_columns);
-		resize(m,m);
-	}
-
-	for ( int i = 0 ; i < m_rows ; i++ ) {
-		for ( int j = i+1 ; j < m_columns ; j++ ) {
-			T tmp = m_matrix[i][j];
-			m_matrix[i][j] = m_matrix[j][i];
-			m_matrix[j][i] = tmp;
+	const int block = 16;
+	Matrix<T> t(m_columns, m_rows);
+	for ( int i0 = 0 ; i0 < m_rows ; i0 += block ) {
+		int i1 = std::min<int>(i0 + block, m_rows);
+		for ( int j0 = 0 ; j0 < m_columns ; j0 += block ) {
+			int j1 = std::min<int>(j0 + block, m_columns);
+			for ( int i = i0 ; i < i1 ; i++ ) {
+				const T *r = row(i);
+				for ( int j = j0 ; j < j1 ; j++ )
+					t.row(j)[i] = r[j];
+			}
 		}
 	}
-
-	if ( new_columns != new_rows ) {
-		// trim off excess.
-		resize(new_rows, new_columns);
-	}
+	swap(t);
 
 	return *this;
 }
 
+// row i of the product is the sum of the rows x of other weighted by (i,x): the inner loop runs
+// over contiguous rows, and every element is summed in the order of x as before
 template <class T>
-Matrix<T> Matrix<T>::product(Matrix<T> &other) {
-	assert( m_matrix != NULL );
-	assert( other.m_matrix != NULL );
+Matrix<T> Matrix<T>::product(const Matrix<T> &other) const {
+	assert( m_data != NULL );
+	assert( other.m_data != NULL );
 	assert ( m_columns == other.m_rows );
 
 	Matrix<T> out(m_rows, other.m_columns);
 
 	for ( int i = 0 ; i < out.m_rows ; i++ ) {
-		for ( int j = 0 ; j < out.m_columns ; j++ ) {
-			for ( int x = 0 ; x < m_columns ; x++ ) {
-				out(i,j) += m_matrix[i][x] * other.m_matrix[x][j];
-			}
+		T *o = out.row(i);
+		const T *a = row(i);
+		for ( int x = 0 ; x < m_columns ; x++ ) {
+			const T a_ix = a[x];
+			const T *b = other.row(x);
+			for ( int j = 0 ; j < out.m_columns ; j++ )
+				o[j] += a_ix * b[j];
 		}
 	}
 
@@ -262,10 +276,202 @@ T&Matrix<T>::operator ()(int x, int y)
 	assert ( y >= 0 );
 	assert ( x < m_rows );
 	assert ( y < m_columns );
-	assert ( m_matrix != NULL );
-	return m_matrix[x][y];
+	assert ( m_data != NULL );
+	return m_data[(size_t)x * m_stride + y];
 }
 
+template <class T>
+const T&Matrix<T>::operator ()(int x, int y) const
+{
+	assert ( x >= 0 );
+	assert ( y >= 0 );
+	assert ( x < m_rows );
+	assert ( y < m_columns );
+	assert ( m_data != NULL );
+	return m_data[(size_t)x * m_stride + y];
+}
 
-#endif /* !defined(_MATRIX_H_) */
+// a bit per element, a row takes stride() words. operator () returns a reference to the bit.
+// clear, transpose and product work on whole words: the boolean product ORs the rows of other.
+template <>
+class Matrix<bool> {
+public:
+#ifdef _MSC_VER
+	typedef unsigned long word;		//_BitScanForward works on 32-bit words
+#else
+	typedef unsigned long long word;
+#endif
+	enum { word_bits = 8 * sizeof(word) };
+	int m_rows;
+	int m_columns;
+
+	class reference {
+	public:
+		reference(word *w, word mask) : m_word(w), m_mask(mask) {}
+		operator bool () const {
+			return (*m_word & m_mask) != 0;
+		}
+		reference & operator= (bool value) {
+			if ( value )
+				*m_word |= m_mask;
+			else
+				*m_word &= ~m_mask;
+			return *this;
+		}
+		reference & operator= (const reference &other) {
+			return *this = (bool)other;
+		}
+	private:
+		word *m_word;
+		word m_mask;
+	};
+
+public:
+	Matrix() : m_rows(0), m_columns(0), m_data(NULL), m_stride(0) {}
+	Matrix(int rows, int columns) : m_rows(0), m_columns(0), m_data(NULL), m_stride(0) {
+		resize(rows, columns);
+	}
+	Matrix(const Matrix<bool> &other) : m_rows(other.m_rows), m_columns(other.m_columns), m_data(NULL), m_stride(other.m_stride) {
+		if ( other.m_data != NULL ) {
+			size_t n = (size_t)m_rows * m_stride;
+			m_data = new word[n];
+			memcpy(m_data, other.m_data, n * sizeof(word));
+		}
+	}
+	Matrix<bool> & operator= (const Matrix<bool> &other) {
+		if ( this != &other ) {
+			Matrix<bool> copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+#ifdef _matrix_move
+	Matrix(Matrix<bool> &&other) : m_rows(0), m_columns(0), m_data(NULL), m_stride(0) {
+		swap(other);
+	}
+	Matrix<bool> & operator= (Matrix<bool> &&other) {
+		swap(other);
+		return *this;
+	}
+#endif
+	~Matrix() {
+		delete [] m_data;
+	}
+
+	// keeps the elements of the common rows and columns, the others are false
+	void resize(int rows, int columns) {
+		if ( m_data != NULL && rows == m_rows && columns == m_columns )
+			return;
+		Matrix<bool> m;
+		m.m_rows = rows;
+		m.m_columns = columns;
+		m.m_stride = (columns + word_bits - 1) / word_bits;
+		m.m_data = new word[(size_t)rows * m.m_stride];
+		m.clear();
+		int minrows = std::min<int>(rows, m_rows);
+		int mincols = std::min<int>(columns, m_columns);
+		for ( int x = 0 ; x < minrows ; x++ ) {
+			int k;
+			for ( k = 0 ; k < mincols / word_bits ; k++ )
+				m.row(x)[k] = row(x)[k];
+			if ( mincols % word_bits )
+				m.row(x)[k] = row(x)[k] & (((word)1 << (mincols % word_bits)) - 1);
+		}
+		swap(m);
+	}
+	void clear(void) {
+		assert( m_data != NULL );
+		memset(m_data, 0, (size_t)m_rows * m_stride * sizeof(word));
+	}
+	void identity(void) {
+		clear();
+		int x = std::min<int>(m_rows, m_columns);
+		for ( int i = 0 ; i < x ; i++ )
+			(*this)(i,i) = true;
+	}
+	reference operator () (int x, int y) {
+		assert ( x >= 0 && x < m_rows );
+		assert ( y >= 0 && y < m_columns );
+		return reference(row(x) + y / word_bits, (word)1 << (y % word_bits));
+	}
+	bool operator () (int x, int y) const {
+		assert ( x >= 0 && x < m_rows );
+		assert ( y >= 0 && y < m_columns );
+		return (row(x)[y / word_bits] >> (y % word_bits)) & 1;
+	}
+	// the words of row x, the bits past m_columns are zero
+	word* row(int x) {
+		return m_data + (size_t)x * m_stride;
+	}
+	const word* row(int x) const {
+		return m_data + (size_t)x * m_stride;
+	}
+	int stride(void) const {
+		return m_stride;
+	}
+	Matrix<bool>& transpose(void) {
+		assert( m_rows > 0 );
+		assert( m_columns > 0 );
+		Matrix<bool> t(m_columns, m_rows);
+		for ( int i = 0 ; i < m_rows ; i++ ) {
+			const word *r = row(i);
+			word bit = (word)1 << (i % word_bits);
+			for ( int k = 0 ; k < m_stride ; k++ )
+				for ( word w = r[k] ; w != 0 ; w &= w - 1 ) {
+					int j = k * word_bits + lowestBit(w);
+					t.row(j)[i / word_bits] |= bit;
+				}
+		}
+		swap(t);
+		return *this;
+	}
+	Matrix<bool> product(const Matrix<bool> &other) const {
+		assert( m_data != NULL );
+		assert( other.m_data != NULL );
+		assert ( m_columns == other.m_rows );
+		Matrix<bool> out(m_rows, other.m_columns);
+		for ( int i = 0 ; i < m_rows ; i++ ) {
+			word *o = out.row(i);
+			const word *a = row(i);
+			for ( int k = 0 ; k < m_stride ; k++ )
+				for ( word w = a[k] ; w != 0 ; w &= w - 1 ) {
+					const word *b = other.row(k * word_bits + lowestBit(w));
+					for ( int j = 0 ; j < out.m_stride ; j++ )
+						o[j] |= b[j];
+				}
+		}
+		return out;
+	}
+	int minsize(void) {
+		return ((m_rows < m_columns) ? m_rows : m_columns);
+	}
+	int columns(void) {
+		return m_columns;
+	}
+	int rows(void) {
+		return m_rows;
+	}
 
+private:
+	word *m_data;
+	int m_stride;
+	// w must not be zero
+	static int lowestBit(word w) {
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, w);
+		return (int)index;
+#else
+		return __builtin_ctzll(w);
+#endif
+	}
+	void swap(Matrix<bool> &other) {
+		std::swap(m_data, other.m_data);
+		std::swap(m_rows, other.m_rows);
+		std::swap(m_columns, other.m_columns);
+		std::swap(m_stride, other.m_stride);
+	}
+};
+
+
+#endif /* !defined(_MATRIX_H_) */
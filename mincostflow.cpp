@@ -0,0 +1,91 @@
+#include "mincostflow.h"
+#include <iostream>
+#include <algorithm>
+using namespace std;
+
+void MinCostFlow::reset(int n)
+{
+	nNode=n;
+	head.assign(n,-1);
+	next.clear();to.clear();cap.clear();cost.clear();
+}
+int MinCostFlow::addArc(int from,int to_node,float capacity,float c)
+{
+	int a=(int)to.size();
+	to.push_back(to_node);	cap.push_back(capacity);	cost.push_back(c);
+	next.push_back(head[from]);	head[from]=a;
+	// reverse arc
+	to.push_back(from);	cap.push_back(0);	cost.push_back(-c);
+	next.push_back(head[to_node]);	head[to_node]=a+1;
+	return a;
+}
+bool MinCostFlow::shortestPath(int s,int t)
+{
+	dist.assign(nNode,Infinity);
+	prev.assign(nNode,-1);
+	done.assign(nNode,0);
+	PQ.reserve((int)to.size()+1);
+	PQ.makeEmpty();
+	dist[s]=0;
+	PQ.insert(Comparable(s,0));
+	while (!PQ.isEmpty())
+	{
+		int u=PQ.deleteMin().index;
+		if (done[u])	// out of date entry
+			continue;
+		done[u]=1;
+		for (int a=head[u];a>=0;a=next[a])
+		{
+			int v=to[a];
+			if (cap[a]<=0||done[v])
+				continue;
+			// the reduced cost is nonnegative up to rounding
+			double d=dist[u]+max(0.0,cost[a]+potential[u]-potential[v]);
+			if (d<dist[v])
+			{
+				dist[v]=d;
+				prev[v]=a;
+				PQ.insert(Comparable(v,(float)d));
+			}
+		}
+	}
+	if (dist[t]>=Infinity)
+		return false;
+	for (int v=0;v<nNode;v++)
+		if (dist[v]<Infinity)
+			potential[v]+=dist[v];
+	return true;
+}
+int MinCostFlow::pathLength(int s,int t) const
+{
+	int n=0;
+	for (int v=t;v!=s;v=to[prev[v]^1])
+		if (prev[v]<0||++n>nNode)
+			return -1;
+	return n;
+}
+float MinCostFlow::solve(int s,int t,float amount,float& total_cost)
+{
+	float sent=0;
+	total_cost=0;
+	potential.assign(nNode,0);
+	while (sent<amount&&shortestPath(s,t))
+	{
+		if (pathLength(s,t)<0)
+		{	cerr << "MinCostFlow: the shortest paths are not a tree\n";
+			break;
+		}
+		// push the bottleneck capacity along the shortest path
+		float delta=amount-sent;
+		for (int v=t;v!=s;v=to[prev[v]^1])
+			delta=min(delta,cap[prev[v]]);
+		for (int v=t;v!=s;v=to[prev[v]^1])
+		{
+			cap[prev[v]]-=delta;
+			cap[prev[v]^1]+=delta;
+			total_cost+=delta*cost[prev[v]];
+		}
+		sent+=delta;
+	}
+	return sent;
+}
@@ -0,0 +1,37 @@
+#ifndef mincostflow_H
+#define mincostflow_H
+#include <vector>
+#include "binaryheaps.h"
+#include "elements.h"
+#include "parameter.h"
+using namespace std;
+///////////////////////////////
+// min cost flow by successive shortest paths (Dijkstra with node potentials).
+// arc costs must be nonnegative; integral capacities give an integral optimal flow.
+// the potentials and distances are doubles and the reduced costs are clamped at 0, so that the
+// rounding after many augmentations cannot make Dijkstra relax around residual cycles.
+// reset keeps the memory of the arcs and of the heap, a reused flow does no heap allocation.
+class MinCostFlow
+{
+public:
+	MinCostFlow(int n=0):PQ(0){reset(n);}
+	void reset(int n);	// n nodes without any arc
+	int addArc(int from,int to,float cap,float cost);	// returns the index of the arc
+	// send up to amount units from s to t at min cost, returns the amount sent
+	float solve(int s,int t,float amount,float& total_cost);
+	float flow(int arc) const {return cap[arc^1];}
+
+private:
+	int nNode;
+	// residual arcs, arc a^1 is the reverse arc of arc a
+	vector<int> head,next,to;
+	vector<float> cap,cost;
+	vector<double> potential,dist;
+	vector<int> prev;		// the arc into each node on the shortest path tree
+	vector<char> done;		// the nodes whose distance is final
+	BinaryHeap<Comparable> PQ;
+	bool shortestPath(int s,int t);
+	int pathLength(int s,int t) const;	// arcs from s to t in prev, -1 if prev is not a path
+};
+
+#endif
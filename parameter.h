@@ -6,25 +6,176 @@ const float Infinity=numeric_limits<float>::infinity();
 const float min_error=1e-5;
 enum T_Routing{_KshortestLB,_ECMP};
 
+// the topology, another one can be set on the command line, e.g. -D_Tree
+#if !defined(_Tree)&&!defined(_FatTree)&&!defined(_L2VL2)&&!defined(_VL2)&&!defined(_Bcube)
 #define _VL2
+#endif
+//#define _no_cplex	// without CPLEX: native solvers, the LP-only routines are unavailable
+// the checkpoints and the request log are written by a background thread where the compiler has
+// <thread> (VS2012, or C++11 elsewhere), in the calling thread otherwise (VS2008)
+#if defined(_MSC_VER) ? _MSC_VER>=1700 : __cplusplus>=201103L
+#define _background_io
+#endif
+
+// the size of the topology can be set on the command line, e.g. -DDCN_H=8
+#ifndef DCN_H
+#if defined(_Tree)
+#define DCN_H 2
+#else
+#define DCN_H 4
+#endif
+#endif
+#ifndef DCN_DA
+#define DCN_DA 4
+#endif
+#ifndef DCN_DI
+#define DCN_DI 4
+#endif
 
-#ifdef _Bcube
-const int H=4;
-const int maxDegree=H;
-const int n_server_port=2;
-const int nServer=H*H;
-const int nToR=H;
-const int nAggregate=H;
-const int nServerInRack=H;
-const int Nv=nServer+nToR+nAggregate;
-const int nSwitch=Nv-nServer;
-const int Ne=nServer*4;
 const float gbpsCommodity=1e3;
 
-// DCN parameters
-const int Kspt=4;//K shortest paths for K shortestLB routing 
-const int Kwidest=4;
-const int maxSlot=4;
+///////////////////////////////
+// the topologies as traits, so that engines of several fabrics can live in one process
+// (GraphT<Topo> in graphs.h). a traits class holds the sizes of its network, the routing
+// parameters and the link rates; the sizes a family does not have are 0.
+struct TopologyTraits
+{
+	enum Family{VL2Family,FatTreeFamily,BcubeFamily,L2VL2Family,TreeFamily};
+	static const int H=0;
+	static const int DA=0;
+	static const int DI=0;
+	static const int nAggregate=0;
+	static const int nIntermediate=0;
+	static const int nCore=0;
+	static const int nEdge=0;
+	static const int nEdgePort=0;
+	static float oversubscription(){return 1;}
+	static float gbpsServer2ToR(){return gbpsCommodity;}
+	static float gbpsToR2Agg(){return gbpsCommodity;}
+	static float gbpsAgg2Int(){return gbpsCommodity;}
+	static float gbpsToR2Edge(){return gbpsCommodity;}
+};
+
+template <int k>
+struct BcubeTopology:TopologyTraits
+{
+	static const Family family=BcubeFamily;
+	static const int H=k;
+	static const int maxDegree=H;
+	static const int n_server_port=2;
+	static const int nServer=H*H;
+	static const int nToR=H;
+	static const int nAggregate=H;
+	static const int nServerInRack=H;
+	static const int Nv=nServer+nToR+nAggregate;
+	static const int nSwitch=Nv-nServer;
+	static const int Ne=nServer*4;
+	// DCN parameters
+	static const int Kspt=4;//K shortest paths for K shortestLB routing 
+	static const int Kwidest=4;
+	static const int maxSlot=4;
+};
+
+template <int DA_,int DI_>
+struct VL2Topology:TopologyTraits
+{
+	static const Family family=VL2Family;
+	static const int DA=DA_;
+	static const int DI=DI_;
+	static const int nToR=DA*DI/4;
+	static const int nAggregate=DI;
+	static const int nIntermediate=DA/2;
+	static const int nServerInRack=4;
+	static const int nServer=nServerInRack*nToR;
+	static const int Nv=nServer+nToR+nAggregate+nIntermediate;
+	static const int nSwitch=Nv-nServer;
+	static const int Ne=DA*DI+DA*DI+nServer*2;
+	static const int maxDegree=4;
+	static const int n_server_port=1;
+	static float gbpsServer2ToR(){return gbpsCommodity;}//1Gbps
+	static float gbpsToR2Agg(){return gbpsServer2ToR()*nServerInRack*oversubscription()/2;}//10Gbps
+	static float gbpsAgg2Int(){return gbpsToR2Agg()*oversubscription();}//10Gbps
+	// DCN parameters
+	static const int Kspt=8;//K shortest paths
+	static const int Kwidest=1;
+	static const int maxSlot=2;
+};
+
+template <int H_>
+struct FatTreeTopology:TopologyTraits
+{
+	static const Family family=FatTreeFamily;
+	static const int H=H_;
+	static const int maxDegree=H;
+	static const int n_server_port=1;
+	static const int nServer=H*(H/2)*(H/2);
+	static const int nToR=H*(H/2);
+	static const int nAggregate=H*(H/2);
+	static const int nServerInRack=H/2;
+	static const int nCore=(H/2)*(H/2);
+	static const int Nv=nServer+nToR+nAggregate+nCore;
+	static const int nSwitch=Nv-nServer;
+	static const int Ne=H*H*H*3/2;//H*H*H/2+(H/2)*(H/2)*H*2+(H/2)*(H/2)*H*2;
+	// DCN parameters
+	static const int Kspt=4;//K shortest paths
+	static const int Kwidest=3;
+	static const int maxSlot=4;
+};
+
+template <int H_>
+struct TreeTopology:TopologyTraits
+{
+	static const Family family=TreeFamily;
+	static const int H=H_;
+	static const int maxDegree=H+1;
+	static const int n_server_port=1;
+	static const int nToR=(maxDegree-1)*(maxDegree-1);
+	static const int nAggregate=maxDegree-1;
+	static const int nServerInRack=4;
+	static const int nServer=(maxDegree-1)*(maxDegree-1)*nServerInRack;
+	static const int nSwitch=1+(maxDegree-1)+(maxDegree-1)*(maxDegree-1);
+	static const int Nv=nServer+nSwitch;
+	static const int Ne=Nv-1;
+	static const int nLayer=3;
+	static float oversubscription(){return 0.5;}
+	// DCN parameters
+	static const int Kspt=4;//K shortest paths
+	static const int Kwidest=2;
+	static const int maxSlot=4;
+};
+
+struct L2VL2Topology:TopologyTraits
+{
+	static const Family family=L2VL2Family;
+	static const int nToR=3;
+	static const int nEdge=2;
+	static const int nServerInRack=2;
+	static const int nServer=nServerInRack*nToR;
+	static const int Nv=nServer+nToR+nEdge;
+	static const int nSwitch=Nv-nServer;
+	static const int Ne=2*nToR*nEdge+nServer*2;
+	static const int nEdgePort=nToR;
+	static const int maxDegree=nServerInRack+nEdge>nEdgePort?nServerInRack+nEdge:nEdgePort;
+	static const int n_server_port=1;
+	static float gbpsServer2ToR(){return gbpsCommodity;}//1Gbps
+	static float gbpsToR2Edge(){return gbpsCommodity;}//10Gbps
+	// DCN parameters
+	static const int Kspt=2;//K shortest paths
+	static const int Kwidest=2;
+	static const int maxSlot=2;
+};
+
+// the fabrics of the extra engines, see GRAPH_TOPOLOGIES in graphs.h
+typedef VL2Topology<4,4> VL2_4x4;
+typedef VL2Topology<8,4> VL2_8x4;
+typedef FatTreeTopology<4> FatTree_H4;
+typedef FatTreeTopology<6> FatTree_H6;
+typedef BcubeTopology<4> Bcube_H4;
+
+// the compiled topology: the engine of the build (Graph or Tree) and the global sizes below
+#ifdef _Bcube
+struct CompiledTopology:BcubeTopology<DCN_H>{};
+const int H=CompiledTopology::H;
 // VDC parameters
 const float muArrivaltime=2;//minute
 const float muHoldtime=60; //minute
@@ -34,35 +185,14 @@ const float minB=100;
 const float maxB=700;
 #endif
 #ifdef _VL2
-//const int DA=8;
-//const int DI=4;
-const int DA=4;
-const int DI=4;
-const int nToR=DA*DI/4;
-const int nAggregate=DI;
-const int nIntermediate=DA/2;
-const int nServerInRack=4;
-//const int nServerInRack=2;
-const int nServer=nServerInRack*nToR;
-const int Nv=nServer+nToR+nAggregate+nIntermediate;
-const int nSwitch=Nv-nServer;
-const int Ne=DA*DI+DA*DI+nServer*2;
-const int maxDegree=4;
-const int n_server_port=1;
-const float oversubstription=1;
-//const float oversub_ToR=1;
-//const float oversub_AGG=0.5;
-
-const float gbpsCommodity=1e3;
-const float gbpsServer2ToR=gbpsCommodity;//1Gbps
-//const float gbpsToR2Agg=gbpsServer2ToR*nServerInRack*oversub_ToR/2;//10Gbps
-//const float gbpsAgg2Int=gbpsToR2Agg*(DA/2)*oversub_AGG/(DA/2);//10Gbps
-const float gbpsToR2Agg=gbpsServer2ToR*nServerInRack*oversubstription/2;//10Gbps
-const float gbpsAgg2Int=gbpsToR2Agg*oversubstription;//10Gbps
-// DCN parameters
-const int Kspt=8;//K shortest paths
-const int Kwidest=1;
-const int maxSlot=2;
+struct CompiledTopology:VL2Topology<DCN_DA,DCN_DI>{};
+const int DA=CompiledTopology::DA;
+const int DI=CompiledTopology::DI;
+const int nIntermediate=CompiledTopology::nIntermediate;
+const float oversubstription=CompiledTopology::oversubscription();
+const float gbpsServer2ToR=CompiledTopology::gbpsServer2ToR();
+const float gbpsToR2Agg=CompiledTopology::gbpsToR2Agg();
+const float gbpsAgg2Int=CompiledTopology::gbpsAgg2Int();
 // VDC parameters
 const float muArrivaltime=2;//minute
 const float muHoldtime=60; //minute
@@ -73,23 +203,10 @@ const float maxB=700;
 #endif
 
 #ifdef _FatTree
-const int H=4;
-const int maxDegree=H;
-const int n_server_port=1;
-const int nServer=H*(H/2)*(H/2);
-const int nToR=H*(H/2);
-const int nAggregate=H*(H/2);
-const int nServerInRack=H/2;
-const int nCore=(H/2)*(H/2);
-const int Nv=nServer+nToR+nAggregate+nCore;
-const int nSwitch=Nv-nServer;
-const int Ne=H*H*H*3/2;//H*H*H/2+(H/2)*(H/2)*H*2+(H/2)*(H/2)*H*2;
-const float gbpsCommodity=1e3;
-const float oversubstription=1;
-// DCN parameters
-const int Kspt=4;//K shortest paths
-const int Kwidest=3;
-const int maxSlot=4;
+struct CompiledTopology:FatTreeTopology<DCN_H>{};
+const int H=CompiledTopology::H;
+const int nCore=CompiledTopology::nCore;
+const float oversubstription=CompiledTopology::oversubscription();
 // VDC parameters
 const float muArrivaltime=2;//minute
 const float muHoldtime=60; //minute
@@ -100,23 +217,10 @@ const float maxB=700;
 
 #endif
 #ifdef _Tree
-const int H=2;
-const int maxDegree=H+1;
-const int n_server_port=1;
-const int nToR=(maxDegree-1)*(maxDegree-1);
-const int nAggregate=maxDegree-1;
-const int nServerInRack=4;
-const int nServer=(maxDegree-1)*(maxDegree-1)*nServerInRack;
-const int nSwitch=1+(maxDegree-1)+(maxDegree-1)*(maxDegree-1);
-const int Nv=nServer+nSwitch;
-const int Ne=Nv-1;
-const float gbpsCommodity=1e3;
-const int nLayer=3;
-const float oversubstription=0.5;//;
-// DCN parameters
-const int Kspt=4;//K shortest paths
-const int Kwidest=2;
-const int maxSlot=4;
+struct CompiledTopology:TreeTopology<DCN_H>{};
+const int H=CompiledTopology::H;
+const int nLayer=CompiledTopology::nLayer;
+const float oversubstription=CompiledTopology::oversubscription();//;
 // VDC parameters
 const float muArrivaltime=2;//minute
 const float muHoldtime=60; //minute
@@ -127,24 +231,11 @@ const float maxB=400;
 #endif
 
 #ifdef _L2VL2
-const int nToR=3;
-const int nEdge=2;
-const int nServerInRack=2;
-const int nServer=nServerInRack*nToR;
-const int Nv=nServer+nToR+nEdge;
-const int nSwitch=Nv-nServer;
-const int Ne=2*nToR*nEdge+nServer*2;
-const int nEdgePort=nToR;
-const int maxDegree=max(nServerInRack+nEdge,nEdgePort);
-const int n_server_port=1;
-const float gbpsCommodity=1e3;
-const float gbpsServer2ToR=gbpsCommodity;//1Gbps
-const float gbpsToR2Edge=gbpsCommodity;//10Gbps
-
-// DCN parameters
-const int Kspt=2;//K shortest paths
-const int Kwidest=2;
-const int maxSlot=2;
+struct CompiledTopology:L2VL2Topology{};
+const int nEdge=CompiledTopology::nEdge;
+const int nEdgePort=CompiledTopology::nEdgePort;
+const float gbpsServer2ToR=CompiledTopology::gbpsServer2ToR();
+const float gbpsToR2Edge=CompiledTopology::gbpsToR2Edge();
 // VDC parameters
 const float muArrivaltime=2;//minute
 const float muHoldtime=60; //minute
@@ -153,6 +244,19 @@ const int maxN=8;
 const float minB=100;  
 const float maxB=400;
 #endif
+const int nServer=CompiledTopology::nServer;
+const int Nv=CompiledTopology::Nv;
+const int Ne=CompiledTopology::Ne;
+const int nToR=CompiledTopology::nToR;
+const int nAggregate=CompiledTopology::nAggregate;
+const int nServerInRack=CompiledTopology::nServerInRack;
+const int nSwitch=CompiledTopology::nSwitch;
+const int maxDegree=CompiledTopology::maxDegree;
+const int n_server_port=CompiledTopology::n_server_port;
+// DCN parameters
+const int Kspt=CompiledTopology::Kspt;
+const int Kwidest=CompiledTopology::Kwidest;
+const int maxSlot=CompiledTopology::maxSlot;
 const T_Routing default_routing=_KshortestLB;
 const float randBw=0.5;
 const int Nvdc=20; // number of VDCs allocated to the substrate DCN
@@ -0,0 +1,241 @@
+#include <iostream>
+#include <cstring>
+#include "reqlog.h"
+using namespace std;
+
+void RequestBlock::clear()
+{
+	arrival.clear();	algorithm.clear();	accept.clear();	N.clear();
+	max_utilization.clear();	bandwidth_cost.clear();	revenue.clear();
+	trials.clear();	latency_us.clear();	nPlaced.clear();
+	server.clear();	slot.clear();
+}
+
+void RequestBlock::append(const RequestRecord& r)
+{
+	arrival.push_back(r.arrival);
+	algorithm.push_back(r.algorithm);
+	accept.push_back(r.accept);
+	N.push_back(r.N);
+	max_utilization.push_back(r.max_utilization);
+	bandwidth_cost.push_back(r.bandwidth_cost);
+	revenue.push_back(r.revenue);
+	trials.push_back(r.trials);
+	latency_us.push_back(r.latency_us);
+	if (r.placement)
+	{	nPlaced.push_back((int)r.placement->server.size());
+		server.insert(server.end(),r.placement->server.begin(),r.placement->server.end());
+		slot.insert(slot.end(),r.placement->slot.begin(),r.placement->slot.end());
+	}
+	else
+		nPlaced.push_back(0);
+}
+
+template <class Type>
+static void writeColumn(ofstream& out,const vector<Type>& x)
+{
+	if (!x.empty())
+		out.write((const char*)&x[0],x.size()*sizeof(Type));
+}
+template <class Type>
+static bool readColumn(ifstream& in,vector<Type>& x,int n)
+{
+	x.resize(n);
+	if (n>0)
+		in.read((char*)&x[0],n*sizeof(Type));
+	return (bool)in;
+}
+
+void RequestBlock::write(ofstream& out) const
+{
+	int n=size(),n_placed=(int)server.size();
+	out.write((const char*)&n,sizeof(int));
+	out.write((const char*)&n_placed,sizeof(int));
+	writeColumn(out,arrival);	writeColumn(out,algorithm);	writeColumn(out,accept);	writeColumn(out,N);
+	writeColumn(out,max_utilization);	writeColumn(out,bandwidth_cost);	writeColumn(out,revenue);
+	writeColumn(out,trials);	writeColumn(out,latency_us);	writeColumn(out,nPlaced);
+	writeColumn(out,server);	writeColumn(out,slot);
+}
+
+bool RequestBlock::read(ifstream& in)
+{
+	int n,n_placed;
+	if (!in.read((char*)&n,sizeof(int)))
+		return false;
+	if (!in.read((char*)&n_placed,sizeof(int))||n<0||n_placed<0)
+		return false;
+	return readColumn(in,arrival,n)&&readColumn(in,algorithm,n)&&readColumn(in,accept,n)&&readColumn(in,N,n)
+		&&readColumn(in,max_utilization,n)&&readColumn(in,bandwidth_cost,n)&&readColumn(in,revenue,n)
+		&&readColumn(in,trials,n)&&readColumn(in,latency_us,n)&&readColumn(in,nPlaced,n)
+		&&readColumn(in,server,n_placed)&&readColumn(in,slot,n_placed);
+}
+
+RequestLog::RequestLog(int blockSize,int maxBlocks)
+	:blockSize(max(blockSize,1)),maxBlocks(max(maxBlocks,1)),current(0),closing(false)
+{
+}
+
+RequestLog::~RequestLog()
+{
+	close();
+}
+
+bool RequestLog::open(const char* filename)
+{
+	close();
+	out.open(filename,ios::out|ios::binary);
+	if (!out) {
+		cerr << "Cannot open " << filename << " for output\n";
+		return false;
+	}
+	out.write(requestLogMagic,4);
+	out.write((const char*)&requestLogVersion,sizeof(requestLogVersion));
+	closing=false;
+	current=new RequestBlock;
+#ifdef _background_io
+	writer=thread(&RequestLog::run,this);
+#endif
+	return true;
+}
+
+void RequestLog::append(const RequestRecord& r)
+{
+	if (!current)
+		return;
+	current->append(r);
+	if (current->size()>=blockSize)
+	{	push(current);
+		current=0;
+#ifdef _background_io
+		unique_lock<mutex> guard(lock);
+#endif
+		if (!spare.empty())
+		{	current=spare.back();
+			spare.pop_back();
+		}
+#ifdef _background_io
+		guard.unlock();
+#endif
+		if (!current)
+			current=new RequestBlock;
+	}
+}
+
+void RequestLog::push(RequestBlock* block)
+{
+#ifdef _background_io
+	unique_lock<mutex> guard(lock);
+	while ((int)full.size()>=maxBlocks)
+		notFull.wait(guard);
+	full.push_back(block);
+	notEmpty.notify_one();
+#else
+	block->write(out);
+	block->clear();
+	spare.push_back(block);
+#endif
+}
+
+#ifdef _background_io
+void RequestLog::run()
+{
+	for (;;)
+	{
+		unique_lock<mutex> guard(lock);
+		while (full.empty()&&!closing)
+			notEmpty.wait(guard);
+		if (full.empty())
+			return;
+		RequestBlock* block=full.front();
+		full.pop_front();
+		notFull.notify_one();
+		guard.unlock();
+		block->write(out);
+		block->clear();
+		guard.lock();
+		spare.push_back(block);
+	}
+}
+#endif
+
+void RequestLog::close()
+{
+	if (!isOpen())
+		return;
+	if (current->size()>0)
+		push(current);
+	else
+		delete current;
+	current=0;
+#ifdef _background_io
+	{
+		unique_lock<mutex> guard(lock);
+		closing=true;
+		notEmpty.notify_one();
+	}
+	writer.join();
+#endif
+	for (size_t k=0;k<spare.size();k++)
+		delete spare[k];
+	spare.clear();
+	out.close();
+}
+
+bool RequestLogReader::open(const char* filename)
+{
+	in.open(filename,ios::in|ios::binary);
+	if (!in) {
+		cerr << "Cannot open " << filename << " for input\n";
+		return false;
+	}
+	char magic[4];
+	unsigned int version=0;
+	in.read(magic,4);
+	in.read((char*)&version,sizeof(version));
+	if (!in||memcmp(magic,requestLogMagic,4)!=0||version!=requestLogVersion) {
+		cerr << filename << " is not a request log of version " << requestLogVersion << "\n";
+		in.close();
+		return false;
+	}
+	return true;
+}
+
+bool RequestLogReader::next(RequestBlock& block)
+{
+	if (!in.is_open())
+		return false;
+	return block.read(in);
+}
+
+// same sums as ProcessRequest, in the same order
+float aggregate(const char* filename,float &max_utilization,float &success_rate,float &bandwidth_cost,float &RC)
+{
+	success_rate=0,max_utilization=0,bandwidth_cost=0,RC=0;
+	RequestLogReader reader;
+	if (!reader.open(filename))
+		return 0;
+	RequestBlock block;
+	int n_success=0,n_req=0;
+	float revenue=0;
+	double t=0;
+	while (reader.next(block))
+		for (int k=0;k<block.size();k++)
+		{
+			n_req++;
+			t=block.arrival[k];
+			if (!block.accept[k])
+				continue;
+			n_success++;
+			revenue+=block.revenue[k];
+			max_utilization+=block.max_utilization[k];
+			bandwidth_cost+=block.bandwidth_cost[k];
+		}
+	if (n_req>0)
+		success_rate=(float)n_success/(float)n_req;
+	if (n_success>0){
+		max_utilization=max_utilization/(float)n_success;
+		bandwidth_cost=bandwidth_cost/(float)n_success;
+		RC=revenue/t;
+	}
+	return success_rate;
+}
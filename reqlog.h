@@ -0,0 +1,111 @@
+#ifndef reqlog_H
+#define reqlog_H
+#include <vector>
+#include <deque>
+#include <fstream>
+#include "elements.h"
+#ifdef _background_io
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+using namespace std;
+///////////////////////////////
+// per-request log of the dynamic simulation (ProcessRequest).
+//
+// the file is append-only and columnar: "VDCL", uint32 version, then blocks of
+//	int32 n, int32 nPlaced_total,
+//	double arrival[n], char algorithm[n], char accept[n], int32 N[n],
+//	float max_utilization[n], float bandwidth_cost[n], float revenue[n],
+//	int32 trials[n], float latency_us[n], int32 nPlaced[n],
+//	int32 server[nPlaced_total], int32 slot[nPlaced_total]
+// the placement of request k is the nPlaced[k] (server,slot) pairs that follow the ones of request k-1.
+// max_utilization, bandwidth_cost and revenue are 0 for the rejected requests.
+
+struct RequestRecord
+{
+	double arrival;			// arrival time
+	char algorithm;
+	bool accept;
+	int N;					// number of VMs
+	float max_utilization;	// of the network after the VDC is admitted
+	float bandwidth_cost;	// bandwidth reserved for the VDC
+	float revenue;			// (kv*N+kb*sum(B))*Holdtime
+	int trials;				// number of congestion checks of the placement algorithm
+	float latency_us;		// running time of the placement algorithm
+	const SparseSolution* placement;	// the servers and slots of the VDC, 0 if rejected
+
+	RequestRecord():arrival(0),algorithm(0),accept(false),N(0),max_utilization(0),bandwidth_cost(0),
+		revenue(0),trials(0),latency_us(0),placement(0){}
+};
+
+// a block of records, one vector per column
+struct RequestBlock
+{
+	vector<double> arrival;
+	vector<char> algorithm,accept;
+	vector<int> N;
+	vector<float> max_utilization,bandwidth_cost,revenue;
+	vector<int> trials;
+	vector<float> latency_us;
+	vector<int> nPlaced;
+	vector<int> server,slot;
+
+	int size() const {return (int)arrival.size();}
+	void clear();
+	void append(const RequestRecord& r);
+	void write(ofstream& out) const;
+	bool read(ifstream& in);
+};
+
+const char requestLogMagic[4]={'V','D','C','L'};
+const unsigned int requestLogVersion=1;
+
+// the records are buffered in blocks, the full blocks are written by a background thread so that
+// the file I/O is not timed with the placement. at most maxBlocks blocks wait for the writer,
+// append blocks when the queue is full. without _background_io (parameter.h) a full block is
+// written by append itself.
+class RequestLog
+{
+public:
+	explicit RequestLog(int blockSize=4096,int maxBlocks=8);
+	~RequestLog();
+	bool open(const char* filename);
+	void append(const RequestRecord& r);
+	void close();		// flush the records and join the writer
+	bool isOpen() const {return current!=0;}
+
+private:
+	int blockSize,maxBlocks;
+	ofstream out;
+	RequestBlock* current;
+	deque<RequestBlock*> full;		// blocks waiting for the writer
+	vector<RequestBlock*> spare;	// written blocks to be reused
+	bool closing;
+#ifdef _background_io
+	mutex lock;
+	condition_variable notEmpty,notFull;
+	thread writer;
+	void run();
+#endif
+
+	void push(RequestBlock* block);
+	RequestLog(const RequestLog&);
+	RequestLog& operator=(const RequestLog&);
+};
+
+// read a log back block by block
+class RequestLogReader
+{
+public:
+	bool open(const char* filename);
+	bool next(RequestBlock& block);		// false at the end of the log
+	void close(){in.close();}
+private:
+	ifstream in;
+};
+
+// the summary metrics of ProcessRequest from a log, returns the success rate
+float aggregate(const char* filename,float &max_utilization,float &success_rate,float &bandwidth_cost,float &RC);
+
+#endif
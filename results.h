@@ -3,7 +3,9 @@
 #include "Graphs.h"
 #include "Trees.h"
 #include "parameter.h"
+#include "resultsink.h"
 #include <ctime>
+#include <cstdio>
 using namespace std;
 void testKSP(Graph& G)
 {
@@ -27,436 +29,283 @@ void testKSP(Graph& G)
 }
 
 
-void output2txt(float* x,int size,char *filename)
+// the text files of output2txt, as the Matlab scripts read them. a file is formatted in memory
+// and written at once
+class LegacyText
 {
-	// open input file
-	ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-        // copy file contents to cout
-
-	int i=0;
-    while (i<size) {
-         	outFile<<x[i]<<" ";
-		 i++;
-    }
-	outFile<<endl;
-	outFile.close();
-}
-// results from dynamic simulation
-void output2txt(int size,float t,float load[],
-				float max_utilization[],float success_rate[],float bw[],float RC[],char *filename)
-{
-	// open input file
-	ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
+public:
+	void family(bool tree)	// the name of the compiled topology family
+	{
+		if (tree)
+		{
+#ifdef _Tree
+			s+="\nTree\n";
+#endif
+			return;
+		}
 #ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
+		s+="\nFatTree\n";
 #endif
 #ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
+		s+="\nL2VL2\n";
 #endif
 #ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
+		s+="\nVL2\n";
 #endif
 #ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
+		s+="\nBcube\n";
 #endif
+	}
+	// "\nlabel x unit"
+	void line(const char* label,int x){s+="\n";s+=label;put(x);}
+	void line(const char* label,float x,const char* unit=""){s+="\n";s+=label;put(x);s+=unit;}
+	// "\nlabel( a , b )"
+	void range(const char* label,int a,int b){s+="\n";s+=label;s+="( ";put(a);s+=" , ";put(b);s+=" )";}
+	void range(const char* label,float a,float b){s+="\n";s+=label;s+="( ";put(a);s+=" , ";put(b);s+=" )";}
+	// "\nlabel" then every value followed by unit, without the line break if label is 0
+	template <class Type> void values(const char* label,const Type* x,int size,const char* unit=" ")
+	{
+		if (label)
+		{	s+="\n";
+			s+=label;
+		}
+		for (int i=0;i<size;i++)
+		{	put(x[i]);
+			s+=unit;
+		}
+	}
+	void write(const char* filename,bool append)
+	{
+		s+="\n";
+		ofstream outFile(filename,append?ios_base::out|ios_base::app:ios_base::out);
+		if (!outFile)
+		{	cerr << "Cannot open " << filename << " for output\n";
+			return;
+		}
+		outFile.write(s.data(),s.size());
+	}
+private:
+	string s;
+	void put(int x){char c[16];sprintf(c,"%d",x);s+=c;}
+	void put(float x){char c[32];sprintf(c,"%g",x);s+=c;}		// as ostream<<x
+};
+
+// if set, output2txt also writes its rows to resultSink, one row per value of the x axis and
+// labelled with the name of the file
+ResultSink* resultSink=0;
+
+// the arrays of an output2txt call, one value per point of the x axis, 0 if the call has none
+struct LegacyColumns
+{
+	const float *t,*load,*avgBw,*sub_tor,*sub_agg,*max_utilization,*success_rate,*bw,*RC;
+	const int* numOfVM;
+	LegacyColumns():t(0),load(0),avgBw(0),sub_tor(0),sub_agg(0),max_utilization(0),success_rate(0),bw(0),RC(0),
+		numOfVM(0){}
+};
+
+// the rows of an output2txt call to resultSink: the fields of base, replaced by the arrays of c
+static void sinkRows(const char* filename,int size,ResultRow base,const LegacyColumns& c)
+{
+	if (!resultSink)
+		return;
+	string label=filename;
+	size_t slash=label.find_last_of("/\\");
+	if (slash!=string::npos)
+		label=label.substr(slash+1);
+	size_t dot=label.find_last_of('.');
+	if (dot!=string::npos)
+		label=label.substr(0,dot);
+	base.topology=topologyName();
+	base.label=label;
+	for (int i=0;i<size;i++)
+	{
+		ResultRow r=base;
+		if (c.t)	r.running_time=c.t[i];
+		if (c.load)	r.load=c.load[i];
+		if (c.numOfVM)	r.minN=r.maxN=c.numOfVM[i];
+		if (c.avgBw)	r.minBw=r.maxBw=c.avgBw[i];
+		if (c.sub_tor)	r.oversub_ToR=c.sub_tor[i];
+		if (c.sub_agg)	r.oversub_AGG=c.sub_agg[i];
+		if (c.max_utilization)	r.max_utilization=c.max_utilization[i];
+		if (c.success_rate)	r.success_rate=c.success_rate[i];
+		if (c.bw)	r.bandwidth_cost=c.bw[i];
+		if (c.RC)	r.RC=c.RC[i];
+		resultSink->write(r);
+	}
+}
 
-	outFile<<"\n"<<"N=( "<<minN<<" , "<<maxN<<" )";
-	outFile<<"\n"<<"B=( "<<minB<<" , "<<maxB<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
+void output2txt(float* x,int size,char *filename)
+{
+	LegacyText text;
+	text.values(0,x,size);
+	text.write(filename,false);
+}
+// results from dynamic simulation
+void output2txt(int size,float t,float load[],
+				float max_utilization[],float success_rate[],float bw[],float RC[],char *filename)
+{
+	LegacyText text;
+	text.family(false);
+	text.range("N=",minN,maxN);
+	text.range("B=",minB,maxB);
+	text.line("max_Slot= ",maxSlot);
 #ifndef _Tree
-	outFile<<"\n"<<"process time is "<<t<<"ms"; 
+	text.line("process time is ",t,"ms");
 #else
-	outFile<<"\n"<<"process time is "<<t<<"us"; 
+	text.line("process time is ",t,"us");
 #endif
-	int i=0;
-	outFile<<"\n"<<"load = ";
-    while (i<size) {
-         	outFile<<load[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         	outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         	outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"R/C = ";
-    while (i<size) {
-         	outFile<<RC[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	outFile<<endl;
-	outFile.close();
+	text.values("load = ",load,size);
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("R/C = ",RC,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,false);
+
+	ResultRow row;
+	row.dynamic=true;
+	row.minN=minN;	row.maxN=maxN;	row.minBw=minB;	row.maxBw=maxB;
+#ifndef _Tree
+	row.running_time=t;
+#else
+	row.running_time=t/1000;
+#endif
+	LegacyColumns c;
+	c.load=load;	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;	c.RC=RC;
+	sinkRows(filename,size,row,c);
 }
 //K paths results from results from static simulation:N=10,varying B
 void output2txt(Graph& G,int size,float t[],int numOfVM,float avgBw[],
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	//ofstream outFile(filename);
-	ofstream outFile(filename, ios_base::out|ios_base::app);
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
-#endif
-#ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
-#endif
-#ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
-#endif
-#ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
-#endif
-
-	outFile<<"\n"<<"Kmax= "<<G.Kmax;
-	outFile<<"\n"<<"N= "<<numOfVM;
-	//outFile<<"\n"<<"B=( "<<minB<<" , "<<maxB<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-	
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"avgBw= ";
-    while (i<size) {
-         outFile<<avgBw[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(false);
+	text.line("Kmax= ",G.Kmax);
+	text.line("N= ",numOfVM);
+	text.line("max_Slot= ",maxSlot);
+	text.values("process time= ",t,size,"ms ");
+	text.values("avgBw= ",avgBw,size);
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.Kmax=G.Kmax;
+	row.minN=row.maxN=numOfVM;
+	LegacyColumns c;
+	c.t=t;	c.avgBw=avgBw;	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 
 // results from static simulation,N={2,4,6,8,10},B=100-700
 void output2txt(Graph& G,int size,float t[],int numOfVM[],float minBw,float maxBw,
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	ofstream outFile(filename, ios_base::out|ios_base::app);//ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
-#endif
-#ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
-#endif
-#ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
-#endif
-#ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
-#endif
-	outFile<<"\n"<<"Kmax= "<<G.Kmax;
-	//outFile<<"\n"<<"N=( "<<minN<<" , "<<maxN<<" )";
-	outFile<<"\n"<<"B=( "<<minBw<<" , "<<maxBw<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-	
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"VM= ";
-    while (i<size) {
-         outFile<<numOfVM[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(false);
+	text.line("Kmax= ",G.Kmax);
+	text.range("B=",minBw,maxBw);
+	text.line("max_Slot= ",maxSlot);
+	text.values("process time= ",t,size,"ms ");
+	text.values("VM= ",numOfVM,size);
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.Kmax=G.Kmax;
+	row.minBw=minBw;	row.maxBw=maxBw;
+	LegacyColumns c;
+	c.t=t;	c.numOfVM=numOfVM;	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 void output2txt(Graph& G,int size,float t[],int numberOfGroup,int numOfVM[],float minBw,float maxBw,
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	ofstream outFile(filename, ios_base::out|ios_base::app);//ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
-#endif
-#ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
-#endif
-#ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
-#endif
-#ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
-#endif
-	outFile<<"\n"<<"Kmax= "<<G.Kmax;
-	//outFile<<"\n"<<"N=( "<<minN<<" , "<<maxN<<" )";
-	outFile<<"\n"<<"B=( "<<minBw<<" , "<<maxBw<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-
-	outFile << "\n"<<"number of group ="<<numberOfGroup;
-	
-	int i=0;
-	
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"VM= ";
-    while (i<size) {
-         outFile<<numOfVM[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(false);
+	text.line("Kmax= ",G.Kmax);
+	text.range("B=",minBw,maxBw);
+	text.line("max_Slot= ",maxSlot);
+	text.line("number of group =",numberOfGroup);
+	text.values("process time= ",t,size,"ms ");
+	text.values("VM= ",numOfVM,size);
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.Kmax=G.Kmax;
+	row.minBw=minBw;	row.maxBw=maxBw;
+	row.nGroup=numberOfGroup;
+	LegacyColumns c;
+	c.t=t;	c.numOfVM=numOfVM;	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 
 
 void output2txt(Tree& G,int size,float t[],int numOfVM[],float minBw,float maxBw,
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	ofstream outFile(filename, ios_base::out|ios_base::app);//ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _Tree
-	outFile<<"\n"<<"Tree"<<"\n";
-#endif
-
-	//outFile<<"\n"<<"N=( "<<minN<<" , "<<maxN<<" )";
-	outFile<<"\n"<<"B=( "<<minBw<<" , "<<maxBw<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-	
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"VM= ";
-    while (i<size) {
-         outFile<<numOfVM[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(true);
+	text.range("B=",minBw,maxBw);
+	text.line("max_Slot= ",maxSlot);
+	text.values("process time= ",t,size,"ms ");
+	text.values("VM= ",numOfVM,size);
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.minBw=minBw;	row.maxBw=maxBw;
+	LegacyColumns c;
+	c.t=t;	c.numOfVM=numOfVM;	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 
 
 void output2txt(Tree& G,int size,float t[],int numOfVM,float avgBw[],
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	//ofstream outFile(filename);
-	ofstream outFile(filename, ios_base::out|ios_base::app);
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _Tree
-	outFile<<"\n"<<"Tree"<<"\n";
-#endif
-
-	outFile<<"\n"<<"N= "<<numOfVM;
-	//outFile<<"\n"<<"B=( "<<minB<<" , "<<maxB<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-	
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"avgBw= ";
-    while (i<size) {
-         outFile<<avgBw[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(true);
+	text.line("N= ",numOfVM);
+	text.line("max_Slot= ",maxSlot);
+	text.values("process time= ",t,size,"ms ");
+	text.values("avgBw= ",avgBw,size);
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.minN=row.maxN=numOfVM;
+	LegacyColumns c;
+	c.t=t;	c.avgBw=avgBw;	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 
 void output2txt(Graph& G,int size,float t_RA[],int numOfVM[],float minBw,float maxBw,char *filename)
 {
-	// open input file
-	//ofstream outFile(filename);
-	ofstream outFile(filename, ios_base::out|ios_base::app);
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
-#endif
-#ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
-#endif
-#ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
-#endif
-#ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
-#endif
-
-	outFile<<"\n"<<"Kmax= "<<G.Kmax;
-	outFile<<"\n"<<"B=( "<<minBw<<" , "<<maxBw<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-
-	outFile<<"\n"<<"VM= ";
-    while (i<size) {
-         outFile<<numOfVM[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t_RA[i]<<"ms ";
-		 i++;
-    }
-	
-
-    
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(false);
+	text.line("Kmax= ",G.Kmax);
+	text.range("B=",minBw,maxBw);
+	text.line("max_Slot= ",maxSlot);
+	text.values("VM= ",numOfVM,size);
+	text.values("process time= ",t_RA,size,"ms ");
+	text.write(filename,true);
+
+	ResultRow row;
+	row.Kmax=G.Kmax;
+	row.minBw=minBw;	row.maxBw=maxBw;
+	LegacyColumns c;
+	c.t=t_RA;	c.numOfVM=numOfVM;
+	sinkRows(filename,size,row,c);
 }
 
 
@@ -464,148 +313,52 @@ void output2txt(Graph& G,int size,float t_RA[],int numOfVM[],float minBw,float m
 void output2txt(int size,float t[],float sub_tor[],float sub_agg[],int numOfVM1,int numOfVM2,float minBw,float maxBw,
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	ofstream outFile(filename, ios_base::out|ios_base::app);//ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
-#endif
-#ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
-#endif
-#ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
-#endif
-#ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
-#endif
-	//outFile<<"\n"<<"Kmax= "<<G.Kmax;
-	outFile<<"\n"<<"N=( "<<numOfVM1<<" , "<<numOfVM2<<" )";
-	outFile<<"\n"<<"B=( "<<minBw<<" , "<<maxBw<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-
-	i=0;
-	outFile<<"\n"<<"sub_tor = ";
-    while (i<size) {
-         outFile<<sub_tor[i]<<" ";
-		 i++;
-    }
-		i=0;
-	outFile<<"\n"<<"sub_agg = ";
-    while (i<size) {
-         outFile<<sub_agg[i]<<" ";
-		 i++;
-    }
-
-	i=0;
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	
-
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(false);
+	text.range("N=",numOfVM1,numOfVM2);
+	text.range("B=",minBw,maxBw);
+	text.line("max_Slot= ",maxSlot);
+	text.values("sub_tor = ",sub_tor,size);
+	text.values("sub_agg = ",sub_agg,size);
+	text.values("process time= ",t,size,"ms ");
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.minN=numOfVM1;	row.maxN=numOfVM2;	row.minBw=minBw;	row.maxBw=maxBw;
+	LegacyColumns c;
+	c.t=t;	c.sub_tor=sub_tor;	c.sub_agg=sub_agg;
+	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 
 
 void output2txt(int k_path,int size,float t[],float sub_tor[],float sub_agg[],int numOfVM,float minBw,float maxBw,
 				float max_utilization[],float success_rate[],float bw[],char *filename)
 {
-	// open input file
-	ofstream outFile(filename, ios_base::out|ios_base::app);//ofstream outFile(filename);
-
-	if (!outFile) {
-	cerr << "Cannot open" <<filename<<" for output\n";
-	}
-#ifdef _FatTree
-	outFile<<"\n"<<"FatTree"<<"\n";
-#endif
-#ifdef _L2VL2
-	outFile<<"\n"<<"L2VL2"<<"\n";
-#endif
-#ifdef _VL2
-	outFile<<"\n"<<"VL2"<<"\n";
-#endif
-#ifdef _Bcube
-	outFile<<"\n"<<"Bcube"<<"\n";
-#endif
-	outFile<<"\n"<<"Kmax= "<<k_path;
-	outFile<<"\n"<<"N= "<<numOfVM;
-	outFile<<"\n"<<"B=( "<<minBw<<" , "<<maxBw<<" )";
-	outFile<<"\n"<<"max_Slot= "<<maxSlot;
-	
-	int i=0;
-
-	i=0;
-	outFile<<"\n"<<"sub_tor = ";
-    while (i<size) {
-         outFile<<sub_tor[i]<<" ";
-		 i++;
-    }
-		i=0;
-	outFile<<"\n"<<"sub_agg = ";
-    while (i<size) {
-         outFile<<sub_agg[i]<<" ";
-		 i++;
-    }
-
-	i=0;
-	outFile<<"\n"<<"process time= ";
-	
-    while (i<size) {
-         outFile<<t[i]<<"ms ";
-		 i++;
-    }
-	
-
-	i=0;
-	outFile<<"\n"<<"MLU = ";
-    while (i<size) {
-         outFile<<max_utilization[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"success_rate = ";
-    while (i<size) {
-         outFile<<success_rate[i]<<" ";
-		 i++;
-    }
-	i=0;
-	outFile<<"\n"<<"bandwidth_cost = ";
-    while (i<size) {
-         outFile<<bw[i]<<" ";
-		 i++;
-    }
-	
-	outFile<<endl;
-	outFile.close();
+	LegacyText text;
+	text.family(false);
+	text.line("Kmax= ",k_path);
+	text.line("N= ",numOfVM);
+	text.range("B=",minBw,maxBw);
+	text.line("max_Slot= ",maxSlot);
+	text.values("sub_tor = ",sub_tor,size);
+	text.values("sub_agg = ",sub_agg,size);
+	text.values("process time= ",t,size,"ms ");
+	text.values("MLU = ",max_utilization,size);
+	text.values("success_rate = ",success_rate,size);
+	text.values("bandwidth_cost = ",bw,size);
+	text.write(filename,true);
+
+	ResultRow row;
+	row.Kmax=k_path;
+	row.minN=row.maxN=numOfVM;	row.minBw=minBw;	row.maxBw=maxBw;
+	LegacyColumns c;
+	c.t=t;	c.sub_tor=sub_tor;	c.sub_agg=sub_agg;
+	c.max_utilization=max_utilization;	c.success_rate=success_rate;	c.bw=bw;
+	sinkRows(filename,size,row,c);
 }
 
 
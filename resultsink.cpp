@@ -0,0 +1,251 @@
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "resultsink.h"
+#include "parameter.h"
+using namespace std;
+
+string topologyName()
+{
+	ostringstream name;
+#if defined(_Tree)
+	name<<"Tree_H"<<H;
+#elif defined(_FatTree)
+	name<<"FatTree_H"<<H;
+#elif defined(_L2VL2)
+	name<<"L2VL2";
+#elif defined(_VL2)
+	name<<"VL2_"<<DA<<"x"<<DI;
+#else
+	name<<"Bcube_H"<<H;
+#endif
+	return name.str();
+}
+
+const int nameLength=24;		// of a column in the schema
+const int topologyLength=16,labelLength=32;
+
+ResultSink::ResultSink(int blockSize,int bufSize)
+	:blockSize(max(blockSize,1)),bufSize(max(bufSize,1)),format(CSV),n_row(0)
+{
+	buildSchema();
+	block.resize(columns.size());
+}
+
+void ResultSink::buildSchema()
+{
+	columns.clear();
+	columns.push_back(ResultColumn("topology",'c',topologyLength));
+	columns.push_back(ResultColumn("label",'c',labelLength));
+	columns.push_back(ResultColumn("algorithm",'c'));
+	columns.push_back(ResultColumn("dynamic",'i'));
+	columns.push_back(ResultColumn("Kmax",'i'));
+	columns.push_back(ResultColumn("minN",'i'));
+	columns.push_back(ResultColumn("maxN",'i'));
+	columns.push_back(ResultColumn("minBw",'f'));
+	columns.push_back(ResultColumn("maxBw",'f'));
+	columns.push_back(ResultColumn("load",'f'));
+	columns.push_back(ResultColumn("replication",'i'));
+	columns.push_back(ResultColumn("oversub_ToR",'f'));
+	columns.push_back(ResultColumn("oversub_AGG",'f'));
+	columns.push_back(ResultColumn("nGroup",'i'));
+	columns.push_back(ResultColumn("success_rate",'f'));
+	columns.push_back(ResultColumn("max_utilization",'f'));
+	columns.push_back(ResultColumn("bandwidth_cost",'f'));
+	columns.push_back(ResultColumn("RC",'f'));
+	columns.push_back(ResultColumn("running_time",'f'));
+	for (int k=0;k<PhaseProfile::nPhase;k++)
+	{
+		string phase=PhaseProfile::name(k);
+		columns.push_back(ResultColumn(phase+"_count",'i'));
+		columns.push_back(ResultColumn(phase+"_mean",'f'));
+		columns.push_back(ResultColumn(phase+"_p50",'f'));
+		columns.push_back(ResultColumn(phase+"_p90",'f'));
+		columns.push_back(ResultColumn(phase+"_p99",'f'));
+		columns.push_back(ResultColumn(phase+"_max",'f'));
+		columns.push_back(ResultColumn(phase+"_hist",'i',LatencyHistogram::numOfBuckets()));
+	}
+}
+
+string ResultSink::preamble() const
+{
+	string s;
+	if (format==CSV)
+	{
+		for (size_t c=0;c<columns.size();c++)
+			if (inCSV((int)c))
+			{	if (!s.empty())
+					s+=',';
+				s+=columns[c].name;
+			}
+		s+='\n';
+		return s;
+	}
+	int n_column=(int)columns.size();
+	s.append(resultMagic,4);
+	s.append((const char*)&resultVersion,4);
+	s.append((const char*)&n_column,4);
+	for (int c=0;c<n_column;c++)
+	{
+		char name[nameLength]={0};
+		strncpy(name,columns[c].name.c_str(),nameLength-1);
+		char type[4]={columns[c].type,0,0,0};
+		s.append(name,nameLength);
+		s.append(type,4);
+		s.append((const char*)&columns[c].width,4);
+	}
+	return s;
+}
+
+bool ResultSink::open(const char* filename,Format format,bool append)
+{
+	close();
+	this->format=format;
+	this->filename=filename;
+	string head=preamble();
+	bool empty=true;
+	if (append)
+	{
+		ifstream in(filename,ios::binary);
+		if (in)
+		{
+			string existing(head.size(),'\0');
+			in.read(&existing[0],head.size());
+			size_t n=(size_t)in.gcount();
+			empty=n==0;
+			if (!empty&&(n<head.size()||existing!=head))
+			{	cerr << filename << " has other columns, cannot append to it\n";
+				return false;
+			}
+		}
+	}
+	out.open(filename,ios::binary|(append?ios::app:ios::trunc));
+	if (!out)
+	{	cerr << "Cannot open " << filename << " for output\n";
+		return false;
+	}
+	if (empty)
+		out.write(head.data(),head.size());
+	return true;
+}
+
+void ResultSink::putString(int c,const string& s)
+{
+	vector<char> x(columns[c].width,'\0');
+	memcpy(&x[0],s.data(),min(s.size(),x.size()));
+	put(c,&x[0],x.size());
+}
+
+void ResultSink::write(const ResultRow& r)
+{
+	if (!isOpen())
+		return;
+	int c=0;
+	putString(c++,r.topology);
+	putString(c++,r.label);
+	put(c++,&r.algorithm,1);
+	putInt(c++,r.dynamic);
+	putInt(c++,r.Kmax);
+	putInt(c++,r.minN);
+	putInt(c++,r.maxN);
+	putFloat(c++,r.minBw);
+	putFloat(c++,r.maxBw);
+	putFloat(c++,r.load);
+	putInt(c++,r.replication);
+	putFloat(c++,r.oversub_ToR);
+	putFloat(c++,r.oversub_AGG);
+	putInt(c++,r.nGroup);
+	putFloat(c++,r.success_rate);
+	putFloat(c++,r.max_utilization);
+	putFloat(c++,r.bandwidth_cost);
+	putFloat(c++,r.RC);
+	putFloat(c++,r.running_time);
+	LatencyHistogram empty;
+	int n_bucket=LatencyHistogram::numOfBuckets();
+	vector<int> counts(n_bucket);
+	for (int k=0;k<PhaseProfile::nPhase;k++)
+	{
+		const LatencyHistogram& h=r.profile?r.profile->histogram[k]:empty;
+		putInt(c++,h.count());
+		putFloat(c++,h.mean());
+		putFloat(c++,h.quantile(0.5f));
+		putFloat(c++,h.quantile(0.9f));
+		putFloat(c++,h.quantile(0.99f));
+		putFloat(c++,h.max());
+		for (int b=0;b<n_bucket;b++)
+			counts[b]=h.bucketCount(b);
+		put(c++,&counts[0],n_bucket*sizeof(int));
+	}
+	n_row++;
+	if (format==CSV)
+	{
+		formatLine();
+		if ((int)buf.size()>=bufSize)
+			flush();
+	}
+	else if (n_row>=blockSize)
+		flush();
+}
+
+// the row in the column buffers as a CSV line, the buffers are cleared
+void ResultSink::formatLine()
+{
+	char s[64];
+	for (size_t c=0;c<columns.size();c++)
+	{
+		const vector<char>& x=block[c];
+		if (inCSV((int)c))
+		{
+			if (c>0)
+				buf+=',';
+			if (columns[c].type=='c')
+				buf.append(x.begin(),find(x.begin(),x.end(),'\0'));
+			else if (columns[c].type=='i')
+			{	int v;
+				memcpy(&v,&x[0],sizeof(int));
+				sprintf(s,"%d",v);
+				buf+=s;
+			}
+			else
+			{	float v;
+				memcpy(&v,&x[0],sizeof(float));
+				sprintf(s,"%g",v);
+				buf+=s;
+			}
+		}
+		block[c].clear();
+	}
+	buf+='\n';
+	n_row=0;
+}
+
+void ResultSink::flush()
+{
+	if (format==CSV)
+	{
+		out.write(buf.data(),buf.size());
+		buf.clear();
+	}
+	else if (n_row>0)
+	{
+		out.write((const char*)&n_row,sizeof(int));
+		for (size_t c=0;c<block.size();c++)
+		{	if (!block[c].empty())
+				out.write(&block[c][0],block[c].size());
+			block[c].clear();
+		}
+		n_row=0;
+	}
+	if (!out)
+		cerr << "Cannot write " << filename << "\n";
+}
+
+void ResultSink::close()
+{
+	if (!isOpen())
+		return;
+	flush();
+	out.close();
+}
@@ -0,0 +1,99 @@
+#ifndef resultsink_H
+#define resultsink_H
+#include <vector>
+#include <string>
+#include <fstream>
+#include "latency.h"
+using namespace std;
+///////////////////////////////
+// typed result files of the experiments, one row per run, instead of the text of output2txt.
+//
+// CSV: a header line with the column names, then one line per row, written through a buffer.
+// binary: columnar with its schema, "VDCR", uint32 version, int32 nColumn, then per column
+//	char name[24], char type, char pad[3], int32 width
+// type is 'c' (char), 'i' (int32) or 'f' (float), a row has width values of the column. then
+// blocks of rows: int32 n, then every column in the order of the schema, n*width values each.
+// Matlab/readResults.m loads it into a struct of columns.
+//
+// the columns, see ResultRow: topology label algorithm dynamic Kmax minN maxN minBw maxBw load
+// replication oversub_ToR oversub_AGG nGroup success_rate max_utilization bandwidth_cost RC
+// running_time, then for each phase of PhaseProfile (release, ..., total) its count, mean, p50,
+// p90, p99 and max (us), e.g. total_p99, and in the binary files its histogram (total_hist,
+// LatencyHistogram::numOfBuckets() counts). topology and label have 16 and 32 chars.
+// a file is appended to only if it has the same columns.
+
+struct ResultRow
+{
+	string topology;		// e.g. VL2_4x4, see topologyName()
+	string label;			// the experiment, e.g. the file of output2txt
+	char algorithm;			// 0 if unknown
+	bool dynamic;			// ProcessRequest instead of SingleRequest
+	int Kmax;				// -1: the default routing or unknown, 0: ECMP, k: k-shortest load balance
+	int minN,maxN;			// VMs of a request
+	float minBw,maxBw;		// bandwidth of a VM
+	float load;				// dynamic runs
+	int replication;
+	float oversub_ToR,oversub_AGG;	// oversubscription of the network links
+	int nGroup;				// groups of the oversubscribed VDCs, 0 if none
+	float success_rate,max_utilization,bandwidth_cost,RC;
+	float running_time;		// per request, ms
+	const PhaseProfile* profile;	// latency histograms, empty if 0
+
+	ResultRow():algorithm(0),dynamic(false),Kmax(-1),minN(0),maxN(0),minBw(0),maxBw(0),load(0),
+		replication(0),oversub_ToR(1),oversub_AGG(1),nGroup(0),success_rate(0),max_utilization(0),
+		bandwidth_cost(0),RC(0),running_time(0),profile(0){}
+};
+
+struct ResultColumn
+{
+	string name;
+	char type;		// 'c', 'i' or 'f'
+	int width;		// values per row
+	ResultColumn(const string& name,char type,int width=1):name(name),type(type),width(width){}
+};
+
+const char resultMagic[4]={'V','D','C','R'};
+const unsigned int resultVersion=1;
+
+// the name of the compiled topology, as the configurations of bench/Makefile
+string topologyName();
+
+class ResultSink
+{
+public:
+	enum Format{CSV,BINARY};
+	// the binary rows are written in blocks of blockSize, the CSV lines through a buffer of bufSize bytes
+	explicit ResultSink(int blockSize=1024,int bufSize=1<<16);
+	~ResultSink(){close();}
+	bool open(const char* filename,Format format,bool append=false);
+	void write(const ResultRow& r);
+	void close();		// flush the rows
+	bool isOpen() const {return out.is_open();}
+	const vector<ResultColumn>& schema() const {return columns;}
+
+private:
+	int blockSize,bufSize;
+	Format format;
+	ofstream out;
+	string filename;
+	vector<ResultColumn> columns;
+	// the values of the rows not written yet, one buffer per column in the layout of the binary
+	// blocks. a CSV line is formatted from them, so both formats follow the order of the schema
+	vector<vector<char> > block;
+	int n_row;
+	string buf;		// CSV: the formatted lines
+
+	void buildSchema();
+	void put(int c,const void* x,size_t size){block[c].insert(block[c].end(),(const char*)x,(const char*)x+size);}
+	void putInt(int c,int x){put(c,&x,sizeof(int));}
+	void putFloat(int c,float x){put(c,&x,sizeof(float));}
+	void putString(int c,const string& s);
+	void formatLine();
+	void flush();
+	string preamble() const;	// the CSV header or the binary schema
+	bool inCSV(int c) const {return columns[c].type=='c'||columns[c].width==1;}
+	ResultSink(const ResultSink&);
+	ResultSink& operator=(const ResultSink&);
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "Graphs.h"
 #include "Trees.h"
 #include "results.h"
+#include "sweep.h"
 #include <ctime>
 using namespace std;
 #ifdef _Tree
@@ -22,18 +23,17 @@ void static_embedding_N(char algorithm)
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
 	
-	time_t Atime,Btime; 
+	Timer timer;
 	
 	float running_time[n]={0};
 	
 	for (int i=0;i<n_test;i++)
 	{
-		time(&Atime); 
+		timer.start();
 		G.SingleRequest(algorithm,numOfreq,
 			p,p_minResBw,p_maxResBw,numOfVM[i],minBw,maxBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		time(&Btime);
-		running_time[i]=1000*(float)(Btime - Atime)/(float)numOfreq;
+		running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 	}
 
@@ -92,20 +92,19 @@ void static_embedding_B(char algorithm)
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
 	
-	time_t Atime,Btime; 
+	Timer timer;
 	
 	float running_time[n]={0};
 
 		
 		for (int i=0;i<n_test;i++)
 		{
-			time(&Atime); 
+			timer.start();
 			G.SingleRequest(algorithm,numOfreq,
 				p,p_minResBw,p_maxResBw,numOfVM,avgBw[i]-devBw,avgBw[i]+devBw,
 				max_utilization[i],success_rate[i],bandwidth_cost[i]);	
 
-			time(&Btime);
-			running_time[i]=1000*(float)(Btime - Atime)/(float)(numOfreq*n_test);
+			running_time[i]=1000*(float)timer.elapsed()/(float)(numOfreq*n_test);
 			cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 		}
 
@@ -152,15 +151,14 @@ void dynamic_embedding(char algorithm)
 	//output
 	float max_utilization[n]={0},success_rate[n]={0},bw_cost[n]={0},RC[n]={0};
 	// start simulation	
-	time_t Atime,Btime; 
-	time(&Atime); 
+	Timer timer;
+	timer.start();
 	float running_time=0;
 	
 	for (int i=0;i<n_test;i++)
 		G.ProcessRequest(algorithm,numOfreq,load[i],max_utilization[i],success_rate[i],bw_cost[i],RC[i]);
 	
-	time(&Btime);
-	running_time=1000*1000*(float)(Btime - Atime)/(float)(numOfreq*n_test);
+	running_time=1000*1000*(float)timer.elapsed()/(float)(numOfreq*n_test);
 	cout<<"process time is "<<running_time<<"us"<<endl;
 	
 	switch(algorithm)
@@ -202,18 +200,17 @@ void static_oversubscribedembedding(char algorithm,bool enLProuting){
 
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 
-	clock_t  Aclock,Bclock;
+	Timer timer;
 
 	float running_time[n]={0};
 
 	for (int i=0;i<n_test;i++)
 	{
-		Aclock=clock();
+		timer.start();
 		G.SingleRequest(algorithm,enLProuting,numberOfreq,
 			p,p_minResBw,p_maxResBw,numberOfGroup,numOfVM[i],numOfVM[i],minBw,maxBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		Bclock=clock();
-		running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numberOfreq);
+		running_time[i]=1000*(float)timer.elapsed()/(float)numberOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 
 	}
@@ -261,16 +258,15 @@ void dynamic_embedding(char algorithm,bool enLProuting)
 	float max_utilization[n]={0},success_rate[n]={0},bw_cost[n]={0},RC[n]={0};
 	// start simulation
 	
-	clock_t  Aclock,Bclock;
-	Aclock=clock();
+	Timer timer;
+	timer.start();
 	float running_time=0;
 	
 	for (int i=0;i<n_test;i++)
 		G.ProcessRequest(algorithm,enLProuting,numOfreq,load[i],
 						max_utilization[i],success_rate[i],bw_cost[i],RC[i]);
 	
-	Bclock=clock();
-	running_time=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq*n_test);
+	running_time=1000*(float)timer.elapsed()/((float)numOfreq*n_test);
 	cout<<"process time is "<<running_time<<"ms"<<endl;
 	
 	switch(algorithm)
@@ -336,18 +332,17 @@ void static_embedding_N(char algorithm,bool enLProuting)
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
 	
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	
 	float running_time[n]={0};
 	
 	for (int i=0;i<n_test;i++)
 	{
-		Aclock=clock();
+		timer.start();
 		G.SingleRequest(algorithm,enLProuting,numOfreq,
 			p,p_minResBw,p_maxResBw,numOfVM[i],numOfVM[i],minBw,maxBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		Bclock=clock();
-		running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+		running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 	}
 
@@ -431,17 +426,16 @@ void static_embedding_B(char algorithm,bool enLProuting)
 	// start simulation
 	
 	
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	float running_time[n]={0};
 		
 	for (int i=0;i<n_test;i++)
 	{
-		Aclock=clock();
+		timer.start();
 		G.SingleRequest(algorithm,enLProuting,numOfreq,
 			p,p_minResBw,p_maxResBw,numOfVM,numOfVM,avgBw[i]-devBw,avgBw[i]+devBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		Bclock=clock();
-		running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+		running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 	}
 
@@ -526,7 +520,7 @@ void static_RA_N(char algorithm,bool enLProuting)
 	//output
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	
 	float running_time[n]={0};
 	float t_RA[n]={0};
@@ -548,12 +542,11 @@ void static_RA_N(char algorithm,bool enLProuting)
 		}
 		for (int i=0;i<n_test;i++)
 		{
-			Aclock=clock();
+			timer.start();
 			G.SingleRequest(algorithm,enLProuting,numOfreq,
 				p,p_minResBw,p_maxResBw,numOfVM[i],minBw,maxBw,
 				max_utilization[i],success_rate[i],bandwidth_cost[i],t_RA[i]);	
-			Bclock=clock(); 
-			running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+			running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 			cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 		}
 	
@@ -646,7 +639,7 @@ void static_RA_B(char algorithm,bool enLProuting)
 	// start simulation
 	
 	
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	float running_time[n]={0};
 	for (int j=0;j<m;j++)
 	{
@@ -666,12 +659,11 @@ void static_RA_B(char algorithm,bool enLProuting)
 		}
 		for (int i=0;i<n_test;i++)
 		{
-			Aclock=clock();
+			timer.start();
 			G.SingleRequest(algorithm,enLProuting,numOfreq,
 				p,p_minResBw,p_maxResBw,numOfVM,numOfVM,avgBw[i]-devBw,avgBw[i]+devBw,
 				max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-			Bclock=clock();
-			running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+			running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 			cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 		}
 
@@ -746,19 +738,18 @@ void static_embedding_oversub(char algorithm,bool enLProuting)
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
 	
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	
 	float running_time[n]={0};
 	
 	for (int i=0;i<n_test;i++)
 	{	Graph G;
 		G.drawVL2(oversub_tor[i],oversub_agg[i]);
-		Aclock=clock();
+		timer.start();
 		G.SingleRequest(algorithm,enLProuting,numOfreq,
 			p,p_minResBw,p_maxResBw,min_numOfVM,max_numOfVM,minBw,maxBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		Bclock=clock();
-		running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+		running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 	}
 
@@ -829,7 +820,7 @@ void static_RA_oversub(char algorithm,bool enLProuting)
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
 	
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	
 	float running_time[n]={0};
 	for (int j=0;j<m;j++){	
@@ -852,12 +843,11 @@ void static_RA_oversub(char algorithm,bool enLProuting)
 				G.routingOption=_KshortestLB;
 				j=m;
 			}
-			Aclock=clock();
+			timer.start();
 			G.SingleRequest(algorithm,enLProuting,numOfreq,
 				p,p_minResBw,p_maxResBw,min_numOfVM,max_numOfVM,minBw,maxBw,
 				max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-			Bclock=clock();
-			running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+			running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 			cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 		}
 
@@ -943,19 +933,18 @@ void Homo_static_embedding_N(char algorithm)
 	float max_utilization[n]={0},success_rate[n]={0},bandwidth_cost[n]={0};
 	// start simulation
 	
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	
 	float running_time[n]={0};
 	
 	G.Kmax=Kspt;
 	for (int i=0;i<n_test;i++)
 	{
-		Aclock=clock();
+		timer.start();
 		G.HomoRequest(algorithm,enLProuting,numOfreq,
 			p,p_minResBw,p_maxResBw,numOfVM[i],minBw,maxBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		Bclock=clock();
-		running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+		running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 	}
 
@@ -1041,18 +1030,17 @@ void Homo_static_embedding_B(char algorithm)
 	bool enLProuting=1;
 
 	// start simulation
-	clock_t  Aclock,Bclock;
+	Timer timer;
 	
 	float running_time[n]={0};
 	G.Kmax=Kspt;
 	for (int i=0;i<n_test;i++)
 	{
-		Aclock=clock();
+		timer.start();
 		G.HomoRequest(algorithm,enLProuting,numOfreq,
 			p,p_minResBw,p_maxResBw,numOfVM,avgBw[i]-devBw,avgBw[i]+devBw,
 			max_utilization[i],success_rate[i],bandwidth_cost[i]);	
-		Bclock=clock();
-		running_time[i]=1000*(float)(Bclock-Aclock)/(CLOCKS_PER_SEC*(float)numOfreq);
+		running_time[i]=1000*(float)timer.elapsed()/(float)numOfreq;
 		cout<<"process time is "<<running_time[i]<<"ms"<<endl;
 	}
 
@@ -1096,8 +1084,59 @@ void Homo_static_embedding_B(char algorithm)
 
 
 
+// static_embedding_N of several algorithms as one parallel sweep
+void sweep_embedding_N()
+{
+	const char algorithms[]={'P','F','N','G','B'};
+	const int numOfVM[]={2,4,6,8,9,10};
+	SweepGrid grid;
+	grid.base.numOfreq=50;
+	grid.base.p=0.5;	grid.base.p_minResBw=0;	grid.base.p_maxResBw=1;
+	grid.base.minBw=100;	grid.base.maxBw=700;
+	grid.algorithms.assign(algorithms,algorithms+5);
+	grid.numOfVM.assign(numOfVM,numOfVM+6);
+
+	vector<SweepPoint> points=grid.expand();
+	vector<SweepResult> results;
+	runSweep(points,results);
+	output2txt(points,results,"sweep_N.txt");
+	outputLatency(points,results,"sweep_N_latency.txt");
+	ResultSink sink;
+	if (sink.open("sweep_N.csv",ResultSink::CSV))
+		writeResults(points,results,sink,"sweep_N");
+}
+// the compiled topology against other fabrics (GRAPH_TOPOLOGIES of graphs.h) as one parallel sweep
+void sweep_topologies()
+{
+	const char* topologies[]={"","VL2_4x4","FatTree_H4","Bcube_H4"};
+	const char algorithms[]={'P','F','B'};
+	const int numOfVM[]={2,4,6,8,10};
+	SweepGrid grid;
+	grid.base.numOfreq=50;
+	grid.base.p=0.5;	grid.base.p_minResBw=0;	grid.base.p_maxResBw=1;
+	grid.base.minBw=100;	grid.base.maxBw=700;
+	grid.topologies.assign(topologies,topologies+4);
+	grid.algorithms.assign(algorithms,algorithms+3);
+	grid.numOfVM.assign(numOfVM,numOfVM+5);
+
+	vector<SweepPoint> points=grid.expand();
+	vector<SweepResult> results;
+	runSweep(points,results);
+	output2txt(points,results,"sweep_topologies.txt");
+	// the rows with their latency histograms, for Matlab/readResults.m
+	ResultSink sink;
+	if (sink.open("sweep_topologies.vdcr",ResultSink::BINARY))
+		writeResults(points,results,sink,"sweep_topologies");
+}
+
 int main()
 {		
+	//sweep_embedding_N();
+	//sweep_topologies();
+	// the rows of output2txt also in one binary file
+	//ResultSink sink;
+	//if (sink.open("results.vdcr",ResultSink::BINARY,true))
+	//	resultSink=&sink;
 	/*for(int i = 0;i < 100;i++){
 		cout<<rand_b01(0.5)<<endl;
 	}*/
@@ -0,0 +1,178 @@
+#include <cmath>
+#include <algorithm>
+#include "steady.h"
+#include "parameter.h"
+using namespace std;
+
+void SteadyState::Batch::merge(const Batch& b)
+{
+	n_req+=b.n_req;	n_success+=b.n_success;
+	max_utilization+=b.max_utilization;	bandwidth_cost+=b.bandwidth_cost;
+	revenue+=b.revenue;	time+=b.time;
+}
+double SteadyState::Batch::value(int m) const
+{
+	switch(m)
+	{
+	case SUCCESS_RATE:		return n_success;
+	case MAX_UTILIZATION:	return max_utilization;
+	case BANDWIDTH_COST:	return bandwidth_cost;
+	default:				return revenue;
+	}
+}
+double SteadyState::Batch::weight(int m) const
+{
+	switch(m)
+	{
+	case SUCCESS_RATE:	return n_req;
+	case RC:			return time;
+	default:			return n_success;	// per admitted VDC
+	}
+}
+
+SteadyState::SteadyState(float relWidth,float confidence,int batchSize,int minBatches,int maxBatches)
+	:relWidth(relWidth),confidence(confidence),batchSize(max(batchSize,1)),
+	minBatches(max(minBatches,2)),maxBatches(max(maxBatches,minBatches))
+{
+	clear();
+}
+
+void SteadyState::clear()
+{
+	batch.clear();
+	current=Batch();
+	done=false;
+	warmup=0;	n_req=0;
+	for (int m=0;m<nMetric;m++)
+	{	estimate[m]=0;
+		halfWidth[m]=Infinity;
+	}
+}
+
+bool SteadyState::add(bool accept,float max_utilization,float bandwidth_cost,float revenue,float interarrival)
+{
+	n_req++;
+	current.n_req++;
+	current.time+=interarrival;
+	if (accept)
+	{	current.n_success++;
+		current.max_utilization+=max_utilization;
+		current.bandwidth_cost+=bandwidth_cost;
+		current.revenue+=revenue;
+	}
+	if (current.n_req<batchSize)
+		return done;
+	batch.push_back(current);
+	current=Batch();
+	if ((int)batch.size()>=2*maxBatches)
+	{	// double the batch size
+		for (int i=0;i<maxBatches;i++)
+		{	batch[i]=batch[2*i];
+			batch[i].merge(batch[2*i+1]);
+		}
+		batch.resize(maxBatches);
+		batchSize*=2;
+	}
+	evaluate();
+	return done;
+}
+
+// ratio estimator R=sum(y)/sum(x) of the batches [d,n) and the standard error of R by the delta method
+static void ratio(const vector<double>& y,const vector<double>& x,int d,double& R,double& se)
+{
+	int n=(int)y.size()-d;
+	double sy=0,sx=0,s2=0;
+	for (int i=d;i<d+n;i++)
+	{	sy+=y[i];
+		sx+=x[i];
+	}
+	if (sx<=0||n<2)
+	{	R=0;	se=Infinity;
+		return;
+	}
+	R=sy/sx;
+	for (int i=d;i<d+n;i++)
+		s2+=(y[i]-R*x[i])*(y[i]-R*x[i]);
+	s2/=n-1;
+	se=sqrt(s2/n)/(sx/n);
+}
+
+// MSER: the d<=n/2 that minimizes the squared standard error of the truncated mean
+int SteadyState::truncation() const
+{
+	int n=(int)batch.size(),the_d=0;
+	const int stopMetric[3]={SUCCESS_RATE,MAX_UTILIZATION,RC};
+	vector<double> y(n),x(n);
+	for (int k=0;k<3;k++)
+	{
+		for (int i=0;i<n;i++)
+		{	y[i]=batch[i].value(stopMetric[k]);
+			x[i]=batch[i].weight(stopMetric[k]);
+		}
+		double best=Infinity;
+		int best_d=0;
+		for (int d=0;d<=n/2;d++)
+		{
+			double R,se;
+			ratio(y,x,d,R,se);
+			if (se<best)
+			{	best=se;
+				best_d=d;
+			}
+		}
+		the_d=max(the_d,best_d);
+	}
+	return the_d;
+}
+
+void SteadyState::evaluate()
+{
+	int n=(int)batch.size();
+	if (n<2)
+		return;
+	int d=truncation();
+	warmup=0;
+	for (int i=0;i<d;i++)
+		warmup+=batch[i].n_req;
+	double t=tQuantile(0.5+confidence/2,n-d-1);
+	vector<double> y(n),x(n);
+	done=n-d>=minBatches;
+	for (int m=0;m<nMetric;m++)
+	{
+		for (int i=0;i<n;i++)
+		{	y[i]=batch[i].value(m);
+			x[i]=batch[i].weight(m);
+		}
+		double R,se;
+		ratio(y,x,d,R,se);
+		estimate[m]=(float)R;
+		halfWidth[m]=(float)(t*se);
+		if (m!=BANDWIDTH_COST&&!(halfWidth[m]<=relWidth*fabs(estimate[m])))
+			done=false;
+	}
+}
+
+void SteadyState::report(ostream& out) const
+{
+	const char* name[nMetric]={"success_rate","max_utilization","bandwidth_cost","RC"};
+	out<<"steady state after "<<warmup<<" of "<<n_req<<" requests, "
+		<<100*confidence<<"% confidence intervals"<<(done?"":" (not converged)")<<"\n";
+	for (int m=0;m<nMetric;m++)
+		out<<name[m]<<" = "<<estimate[m]<<" +- "<<halfWidth[m]<<"\n";
+}
+
+// inverse normal (Abramowitz and Stegun 26.2.23), then the Cornish-Fisher expansion of t
+double tQuantile(double p,int df)
+{
+	double q=p<0.5?p:1-p;
+	double s=sqrt(-2*log(q));
+	double z=s-(2.515517+0.802853*s+0.010328*s*s)/(1+1.432788*s+0.189269*s*s+0.001308*s*s*s);
+	if (p<0.5)
+		z=-z;
+	if (df<=0)
+		return Infinity;
+	double z2=z*z,n=df;
+	return z+z*(z2+1)/(4*n)
+		+z*((5*z2+16)*z2+3)/(96*n*n)
+		+z*(((3*z2+19)*z2+17)*z2-15)/(384*n*n*n);
+}
@@ -0,0 +1,69 @@
+#ifndef steady_H
+#define steady_H
+#include <vector>
+#include <iostream>
+using namespace std;
+///////////////////////////////
+// steady state estimates of a dynamic run (ProcessRequest) by batch means.
+//
+// the requests are grouped in batches of consecutive arrivals. the warm-up batches are
+// found by MSER (the truncation that minimizes the variance of the mean of the remaining
+// batches, at most half of them), the metrics are ratio estimators over the remaining
+// batches, e.g. RC=sum(revenue)/sum(time), with confidence intervals from the variance
+// between the batches. when the number of batches reaches 2*maxBatches, adjacent batches
+// are merged so that the batches grow with the run and their means become uncorrelated.
+// the run can stop once the intervals of success_rate, max_utilization and RC are narrow enough.
+
+class SteadyState
+{
+public:
+	enum Metric{SUCCESS_RATE,MAX_UTILIZATION,BANDWIDTH_COST,RC,nMetric};
+	// stop when the half width of every interval is at most relWidth*|estimate|
+	SteadyState(float relWidth=0.05f,float confidence=0.95f,int batchSize=50,int minBatches=20,int maxBatches=64);
+	void clear();
+	// one request, max_utilization, bandwidth_cost and revenue are 0 if it is rejected.
+	// returns true when the intervals are narrow enough
+	bool add(bool accept,float max_utilization,float bandwidth_cost,float revenue,float interarrival);
+	bool converged() const {return done;}
+	bool hasEstimate() const {return batch.size()>=2;}
+
+	float estimate[nMetric];	// steady state estimates, after the last complete batch
+	float halfWidth[nMetric];	// half widths of the confidence intervals
+	int warmup;					// requests discarded as the transient
+	int n_req;					// requests seen
+	void report(ostream& out) const;
+	template <class Archive> void save(Archive& ar) const
+	{
+		ar.put(batchSize);	ar.put(batch);	ar.put(current);	ar.put(done);
+		ar.put(estimate,nMetric);	ar.put(halfWidth,nMetric);	ar.put(warmup);	ar.put(n_req);
+	}
+	template <class Archive> void load(Archive& ar)
+	{
+		ar.get(batchSize);	ar.get(batch);	ar.get(current);	ar.get(done);
+		ar.get(estimate,nMetric);	ar.get(halfWidth,nMetric);	ar.get(warmup);	ar.get(n_req);
+	}
+
+private:
+	struct Batch
+	{
+		int n_req,n_success;
+		double max_utilization,bandwidth_cost,revenue,time;
+		Batch():n_req(0),n_success(0),max_utilization(0),bandwidth_cost(0),revenue(0),time(0){}
+		void merge(const Batch& b);
+		double value(int m) const;	// numerator of metric m
+		double weight(int m) const;	// denominator of metric m
+	};
+	float relWidth,confidence;
+	int batchSize,minBatches,maxBatches;
+	vector<Batch> batch;
+	Batch current;
+	bool done;
+
+	int truncation() const;		// warm-up batches
+	void evaluate();
+};
+
+// quantile of the Student t distribution with df degrees of freedom
+double tQuantile(double p,int df);
+
+#endif
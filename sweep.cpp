@@ -0,0 +1,323 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "sweep.h"
+#ifdef _Tree
+#include "Trees.h"
+typedef Tree Engine;
+#else
+#include "Graphs.h"
+typedef Graph Engine;
+#endif
+using namespace std;
+
+vector<SweepPoint> SweepGrid::expand() const
+{
+	vector<SweepPoint> points;
+	vector<string> tops(topologies);
+	vector<char> algs(algorithms);
+	vector<int> ks(Kmax);
+	vector<int> ns(numOfVM);
+	vector<pair<float,float> > bws(bandwidth);
+	if (tops.empty())	tops.push_back(base.topology);
+	if (algs.empty())	algs.push_back(base.algorithm);
+	if (ks.empty())		ks.push_back(base.Kmax);
+	if (ns.empty())		ns.push_back(base.numOfVM);
+	if (bws.empty())	bws.push_back(make_pair(base.minBw,base.maxBw));
+	// a dynamic point has no N and B axes
+	int n_static=load.empty()?(int)(ns.size()*bws.size()):(int)load.size();
+	for (size_t t=0;t<tops.size();t++)
+		for (size_t a=0;a<algs.size();a++)
+			for (size_t k=0;k<ks.size();k++)
+				for (int i=0;i<n_static;i++)
+					for (int r=0;r<nReplication;r++)
+					{
+						SweepPoint x(base);
+						x.topology=tops[t];
+						x.algorithm=algs[a];
+						x.Kmax=ks[k];
+						if (load.empty())
+						{	x.dynamic=false;
+							x.numOfVM=ns[i/bws.size()];
+							x.minBw=bws[i%bws.size()].first;
+							x.maxBw=bws[i%bws.size()].second;
+						}
+						else
+						{	x.dynamic=true;
+							x.load=load[i];
+						}
+						x.replication=r;
+						points.push_back(x);
+					}
+	return points;
+}
+
+#ifdef _Tree
+static void drawTopology(Tree& G)
+{
+	G.drawTree();
+}
+// no paths to compute or to copy
+static void routes(Tree&,const Tree*){}
+
+static void runPoint(Tree& G,const SweepPoint& x,SweepResult& y)
+{
+	G.stream=x.replication>0?x.replication:-1;
+	if (x.dynamic)
+		G.ProcessRequest(x.algorithm,x.numOfreq,x.load,
+			y.max_utilization,y.success_rate,y.bandwidth_cost,y.RC);
+	else
+		G.SingleRequest(x.algorithm,x.numOfreq,
+			x.p,x.p_minResBw,x.p_maxResBw,x.numOfVM,x.minBw,x.maxBw,
+			y.max_utilization,y.success_rate,y.bandwidth_cost);
+}
+#else
+template <class Topo>
+static void drawTopology(GraphT<Topo>& G)
+{
+	G.draw();
+}
+// the paths of the master, or computed if there is none
+template <class Topo>
+static void routes(GraphT<Topo>& G,const GraphT<Topo>* master)
+{
+	if (master)
+		G.copyRoutes(*master);
+	else
+		G.computeRoutes();
+}
+
+template <class Topo>
+static void runPoint(GraphT<Topo>& G,const SweepPoint& x,SweepResult& y)
+{
+	G.stream=x.replication>0?x.replication:-1;
+	if (x.Kmax==0)
+	{	G.Kmax=G.Kspt;
+		G.routingOption=_ECMP;
+	}
+	else if (x.Kmax>0)
+	{	G.Kmax=x.Kmax;
+		G.routingOption=_KshortestLB;
+	}
+	else
+	{	G.Kmax=G.Kwidest;
+		G.routingOption=default_routing;
+	}
+	if (x.dynamic)
+		G.ProcessRequest(x.algorithm,x.enLProuting,x.numOfreq,x.load,
+			y.max_utilization,y.success_rate,y.bandwidth_cost,y.RC);
+	else
+		G.SingleRequest(x.algorithm,x.enLProuting,x.numOfreq,
+			x.p,x.p_minResBw,x.p_maxResBw,x.numOfVM,x.numOfVM,x.minBw,x.maxBw,
+			y.max_utilization,y.success_rate,y.bandwidth_cost);
+}
+#endif
+
+// an engine of one topology, so that the points of several topologies share the workers
+class SweepEngine
+{
+public:
+	virtual ~SweepEngine(){}
+	virtual SweepEngine* copy() const=0;	// an engine of the same topology with the paths of this one
+	virtual void run(const SweepPoint& x,SweepResult& y)=0;
+};
+
+template <class E>
+class SweepEngineOf:public SweepEngine
+{
+public:
+	// the network is drawn, the paths are computed if there is no master
+	explicit SweepEngineOf(const E* master=0):G(new E)
+	{
+		drawTopology(*G);
+		routes(*G,master);
+	}
+	~SweepEngineOf(){delete G;}
+	SweepEngine* copy() const {return new SweepEngineOf(G);}
+	void run(const SweepPoint& x,SweepResult& y)
+	{
+		G->profile=&y.profile;
+		runPoint(*G,x,y);
+		G->profile=0;
+	}
+private:
+	E* G;
+	SweepEngineOf(const SweepEngineOf&);
+	SweepEngineOf& operator=(const SweepEngineOf&);
+};
+
+// the master engine of a topology, 0 if it is not compiled
+static SweepEngine* masterEngine(const string& topology)
+{
+	if (topology.empty())
+		return new SweepEngineOf<Engine>;
+#ifndef _Tree
+#define MASTER_ENGINE(Topo) if (topology==#Topo) return new SweepEngineOf<GraphT<Topo> >;
+	GRAPH_TOPOLOGIES(MASTER_ENGINE)
+#undef MASTER_ENGINE
+#endif
+	cerr << "Unknown topology " << topology << "\n";
+	return 0;
+}
+
+// the name of the topology of a point, the compiled one as in bench/Makefile
+static string topologyName(const SweepPoint& x)
+{
+	return x.topology.empty()?topologyName():x.topology;
+}
+
+void runSweep(const vector<SweepPoint>& points,vector<SweepResult>& results,int nThread)
+{
+	int n=(int)points.size();
+	results.assign(n,SweepResult());
+	if (n==0)
+		return;
+	// the topologies of the points, the paths of each one are computed once by its master and
+	// copied into the workers
+	vector<string> topologies;
+	vector<int> topology(n);
+	for (int k=0;k<n;k++)
+	{
+		topology[k]=(int)(find(topologies.begin(),topologies.end(),points[k].topology)-topologies.begin());
+		if (topology[k]==(int)topologies.size())
+			topologies.push_back(points[k].topology);
+	}
+	int n_topology=(int)topologies.size();
+	vector<SweepEngine*> masters(n_topology,(SweepEngine*)0);
+#ifdef _OPENMP
+	if (nThread<=0)
+		nThread=omp_get_max_threads();
+	#pragma omp parallel for schedule(dynamic) num_threads(min(nThread,n_topology))
+#else
+	(void)nThread;		// one worker without OpenMP
+#endif
+	for (int t=0;t<n_topology;t++)
+		masters[t]=masterEngine(topologies[t]);
+#ifdef _OPENMP
+	nThread=min(nThread,n);
+	#pragma omp parallel num_threads(nThread)
+#endif
+	{
+		vector<SweepEngine*> G(n_topology,(SweepEngine*)0);	// created at the first point of their topology
+#ifdef _OPENMP
+		#pragma omp for schedule(dynamic)
+#endif
+		for (int k=0;k<n;k++)
+		{
+			SweepEngine* master=masters[topology[k]];
+			if (!master)
+				continue;
+			SweepEngine*& engine=G[topology[k]];
+			if (!engine)
+				engine=master->copy();
+			Timer timer;
+			currentCounters().clear();
+			engine->run(points[k],results[k]);
+			results[k].counters=currentCounters();
+			results[k].running_time=(float)(1000*timer.elapsed()/points[k].numOfreq);
+		}
+		for (int t=0;t<n_topology;t++)
+			delete G[t];
+	}
+	for (int t=0;t<n_topology;t++)
+		delete masters[t];
+}
+
+void output2txt(const vector<SweepPoint>& points,const vector<SweepResult>& results,const char *filename)
+{
+	ofstream outFile(filename);
+	if (!outFile) {
+	cerr << "Cannot open" <<filename<<" for output\n";
+	return;
+	}
+	outFile<<"topology algorithm dynamic Kmax N minBw maxBw load replication "
+		<<"success_rate max_utilization bandwidth_cost RC running_time(ms) p50(us) p90(us) p99(us) max(us)";
+#ifdef _counters
+	outFile<<" "<<CounterSet::header();
+#endif
+	outFile<<"\n";
+	for (size_t k=0;k<points.size();k++)
+	{
+		const SweepPoint& x=points[k];
+		const SweepResult& y=results[k];
+		outFile<<topologyName(x)<<" "<<x.algorithm<<" "<<x.dynamic<<" "<<x.Kmax<<" "<<x.numOfVM<<" "<<x.minBw<<" "<<x.maxBw<<" "
+			<<x.load<<" "<<x.replication<<" "
+			<<y.success_rate<<" "<<y.max_utilization<<" "<<y.bandwidth_cost<<" "<<y.RC<<" "<<y.running_time<<" ";
+		const LatencyHistogram& h=y.profile.histogram[PhaseProfile::TOTAL];
+		outFile<<h.quantile(0.5f)<<" "<<h.quantile(0.9f)<<" "<<h.quantile(0.99f)<<" "<<h.max();
+#ifdef _counters
+		outFile<<" ";
+		y.counters.write(outFile);
+#endif
+		outFile<<"\n";
+	}
+	outFile.close();
+}
+
+void writeResults(const vector<SweepPoint>& points,const vector<SweepResult>& results,ResultSink& sink,
+	const char* label)
+{
+	for (size_t k=0;k<points.size();k++)
+	{
+		const SweepPoint& x=points[k];
+		const SweepResult& y=results[k];
+		ResultRow r;
+		r.topology=topologyName(x);
+		r.label=label;
+		r.algorithm=x.algorithm;
+		r.dynamic=x.dynamic;
+		r.Kmax=x.Kmax;
+		if (x.dynamic)
+		{	r.minN=minN;	r.maxN=maxN;
+			r.minBw=minB;	r.maxBw=maxB;
+			r.load=x.load;
+		}
+		else
+		{	r.minN=r.maxN=x.numOfVM;
+			r.minBw=x.minBw;	r.maxBw=x.maxBw;
+		}
+		r.replication=x.replication;
+		r.success_rate=y.success_rate;
+		r.max_utilization=y.max_utilization;
+		r.bandwidth_cost=y.bandwidth_cost;
+		r.RC=y.RC;
+		r.running_time=y.running_time;
+		r.profile=&y.profile;
+		sink.write(r);
+	}
+}
+
+void outputLatency(const vector<SweepPoint>& points,const vector<SweepResult>& results,const char *filename)
+{
+	ofstream outFile(filename);
+	if (!outFile) {
+	cerr << "Cannot open" <<filename<<" for output\n";
+	return;
+	}
+	outFile<<"point phase count mean(us) p50(us) p90(us) p99(us) max(us)\n";
+	for (size_t k=0;k<points.size();k++)
+	{
+		ostringstream label;
+		label<<k;
+		results[k].profile.write(outFile,label.str().c_str());
+	}
+	// the points of an algorithm together
+	vector<char> algs;
+	for (size_t k=0;k<points.size();k++)
+		if (find(algs.begin(),algs.end(),points[k].algorithm)==algs.end())
+			algs.push_back(points[k].algorithm);
+	for (size_t a=0;a<algs.size();a++)
+	{
+		PhaseProfile merged;
+		for (size_t k=0;k<points.size();k++)
+			if (points[k].algorithm==algs[a])
+				merged.merge(results[k].profile);
+		string label(1,algs[a]);
+		merged.write(outFile,label.c_str());
+	}
+	outFile.close();
+}
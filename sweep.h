@@ -0,0 +1,77 @@
+#ifndef sweep_H
+#define sweep_H
+#include <vector>
+#include <string>
+#include <utility>
+#include "parameter.h"
+#include "latency.h"
+#include "counters.h"
+#include "resultsink.h"
+using namespace std;
+///////////////////////////////
+// parallel parameter sweep of the static (SingleRequest) and dynamic (ProcessRequest) experiments.
+// the paths of every topology of the points are computed once by its master engine; a worker owns
+// an engine per topology, created at its first point of that topology with a copy of the master's
+// paths. a point is run from a cleared network and its own random stream, so the results do not
+// depend on the number of workers or on the order in which the points are run.
+
+struct SweepPoint
+{
+	string topology;		// empty: the compiled one, else a traits of GRAPH_TOPOLOGIES (graphs.h), e.g. "FatTree_H4"
+	char algorithm;
+	bool dynamic;			// ProcessRequest instead of SingleRequest
+	bool enLProuting;		// Graph only
+	int Kmax;				// Graph only, -1: the default routing, 0: ECMP, k: k-shortest load balance
+	int numOfreq;
+	// static runs
+	float p,p_minResBw,p_maxResBw;	// residual resources of the physical network
+	int numOfVM;
+	float minBw,maxBw;
+	// dynamic runs
+	float load;
+	int replication;		// 0: the seed 0 sequence of the sequential runs, r: random stream r
+
+	SweepPoint():algorithm('P'),dynamic(false),enLProuting(false),Kmax(-1),numOfreq(100),
+		p(0.5),p_minResBw(0),p_maxResBw(1),numOfVM(8),minBw(100),maxBw(700),load(0.5),replication(0){}
+};
+
+struct SweepResult
+{
+	float max_utilization,success_rate,bandwidth_cost,RC;
+	float running_time;		// ms per request
+	PhaseProfile profile;	// latency of the requests
+	CounterSet counters;	// hot path counters, 0 without _counters
+	SweepResult():max_utilization(0),success_rate(0),bandwidth_cost(0),RC(0),running_time(0){counters.clear();}
+};
+
+// a declarative grid: all the combinations of the listed values, the others are taken from base.
+// the points are static if load is empty and dynamic otherwise.
+struct SweepGrid
+{
+	SweepPoint base;
+	vector<string> topologies;
+	vector<char> algorithms;
+	vector<int> Kmax;
+	vector<int> numOfVM;
+	vector<pair<float,float> > bandwidth;	// [minBw,maxBw] of the VMs
+	vector<float> load;
+	int nReplication;
+
+	SweepGrid():nReplication(1){}
+	// topologies, algorithms, Kmax, numOfVM, bandwidth or load, replications in row-major order
+	vector<SweepPoint> expand() const;
+};
+
+// run the points on nThread workers (0: all the cores), results[k] is the result of points[k].
+// the points of a topology that is not compiled are left at 0
+void runSweep(const vector<SweepPoint>& points,vector<SweepResult>& results,int nThread=0);
+// one line per point, in the order of the points, with the counters if _counters is defined.
+// the topology column holds the name of the compiled topology for the points without one
+void output2txt(const vector<SweepPoint>& points,const vector<SweepResult>& results,const char *filename);
+// the rows of the points, labelled label, e.g. to a binary file for Matlab/readResults.m
+void writeResults(const vector<SweepPoint>& points,const vector<SweepResult>& results,ResultSink& sink,
+	const char* label="sweep");
+// the latency histograms of every point, then of every algorithm over its points
+void outputLatency(const vector<SweepPoint>& points,const vector<SweepResult>& results,const char *filename);
+
+#endif
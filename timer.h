@@ -0,0 +1,42 @@
+#ifndef timer_H
+#define timer_H
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+///////////////////////////////
+// monotonic wall clock with sub-microsecond resolution, unlike time() and clock()
+// it does not jump with the system time and it does not count the CPU time of other threads
+
+inline double monotonicTime()	// seconds
+{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency={0};
+	if (frequency.QuadPart==0)
+		QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart/(double)frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return now.tv_sec+1e-9*now.tv_nsec;
+#endif
+}
+
+class Timer
+{
+public:
+	Timer(){start();}
+	void start(){t0=monotonicTime();}
+	double elapsed() const {return monotonicTime()-t0;}		// seconds since start
+	float elapsed_us() const {return (float)(1e6*elapsed());}
+private:
+	double t0;
+};
+
+#endif
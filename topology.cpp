@@ -0,0 +1,377 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include "topology.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+Topology::Topology():nNode(0),nLink(0),slot(0),first(0),adj(0),from(0),to(0),cost(0),bandwidth(0),
+	view(0),viewSize(0)
+{
+#ifdef _WIN32
+	file=mapping=0;
+#endif
+}
+
+Topology::~Topology()
+{
+	close();
+}
+
+void Topology::close()
+{
+	if (view)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(view);
+		CloseHandle((HANDLE)mapping);
+		CloseHandle((HANDLE)file);
+		file=mapping=0;
+#else
+		munmap(view,viewSize);
+#endif
+		view=0;	viewSize=0;
+	}
+	slots.clear();	firsts.clear();	adjs.clear();	froms.clear();	tos.clear();
+	costs.clear();	bandwidths.clear();
+	nNode=nLink=0;
+	slot=first=adj=from=to=0;
+	cost=bandwidth=0;
+}
+
+bool Topology::load(const char* filename)
+{
+	char magic[4]={0};
+	ifstream in(filename,ios::binary);
+	if (!in)
+	{	cerr << "Cannot open " << filename << " for input\n";
+		return false;
+	}
+	in.read(magic,4);
+	in.close();
+	if (memcmp(magic,topologyMagic,4)==0)
+		return mapBinary(filename);
+	// the other binary files of the simulator, e.g. a request trace
+	if (memcmp(magic,topologyMagic,3)==0)
+	{	cerr << filename << " is not a topology\n";
+		return false;
+	}
+	return loadText(filename);
+}
+
+///////////////////////////////
+// text files
+
+static const double powersOf10[]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+	1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+inline bool isDigit(char c){return c>='0'&&c<='9';}
+inline bool isBlank(char c){return c==' '||c=='\t'||c=='\r';}
+
+// the number at p, returns the position after it, or 0 if p is not a number followed by a blank.
+// plain decimals are exact up to 18 digits, the others are left to strtod
+static const char* parseNumber(const char* p,double& x)
+{
+	const char* start=p;
+	bool negative=*p=='-';
+	if (*p=='-'||*p=='+')
+		p++;
+	if (!isDigit(*p)&&!(*p=='.'&&isDigit(p[1])))
+		return 0;
+	unsigned long long m=0;
+	int scale=0;
+	for (;isDigit(*p);p++)
+		if (m<100000000000000000ULL)	m=m*10+(*p-'0');
+		else	scale++;
+	if (*p=='.')
+		for (p++;isDigit(*p);p++)
+			if (m<100000000000000000ULL)
+			{	m=m*10+(*p-'0');
+				scale--;
+			}
+	if (*p=='e'||*p=='E'||scale>22||scale<-22)
+	{	char* end;
+		x=strtod(start,&end);
+		p=end;
+	}
+	else
+	{	x=(double)m;
+		x=scale<0?x/powersOf10[-scale]:x*powersOf10[scale];
+		if (negative)
+			x=-x;
+	}
+	if (*p!='\0'&&*p!='\n'&&!isBlank(*p))
+		return 0;
+	return p;
+}
+
+bool Topology::loadText(const char* filename)
+{
+	close();
+	ifstream in(filename,ios::binary);
+	if (!in)
+	{	cerr << "Cannot open " << filename << " for input\n";
+		return false;
+	}
+	in.seekg(0,ios::end);
+	size_t size=(size_t)in.tellg();
+	in.seekg(0,ios::beg);
+	vector<char> text(size+1);
+	if (size>0)
+		in.read(&text[0],size);
+	if (!in)
+	{	cerr << "Cannot read " << filename << "\n";
+		return false;
+	}
+	text[size]='\0';
+
+	// most lines are links
+	size_t n_line=count(text.begin(),text.end(),'\n')+1;
+	reserve((int)n_line);
+	vector<int> server,server_slot;
+	int line=0,n_bad=0;
+	for (const char* p=&text[0];*p;)
+	{
+		line++;
+		double x[5];
+		int n=0;
+		bool bad=false;
+		while (true)
+		{
+			while (isBlank(*p))
+				p++;
+			if (*p=='\n'||*p=='\0')
+				break;
+			const char* q=n<5?parseNumber(p,x[n]):0;
+			if (!q)
+			{	bad=true;
+				while (*p!='\n'&&*p!='\0')
+					p++;
+				break;
+			}
+			p=q;	n++;
+		}
+		if (*p=='\n')
+			p++;
+		if (!bad&&n==2&&x[0]>=1)
+		{	server.push_back((int)x[0]-1);
+			server_slot.push_back((int)x[1]);
+		}
+		else if (!bad&&n==4&&x[0]>=1&&x[1]>=1)
+		{	froms.push_back((int)x[0]-1);	tos.push_back((int)x[1]-1);
+			costs.push_back((float)x[2]);	bandwidths.push_back((float)x[3]);
+		}
+		else if (bad||n>0)
+		{	if (n_bad++<10)
+				cerr << "Bad line " << line << " of " << filename << "\n";
+		}
+	}
+	if (n_bad>10)
+		cerr << n_bad << " bad lines in " << filename << "\n";
+
+	nNode=0;
+	for (int a=0;a<(int)froms.size();a++)
+		nNode=max(nNode,max(froms[a],tos[a])+1);
+	for (size_t k=0;k<server.size();k++)
+		nNode=max(nNode,server[k]+1);
+	slots.assign(nNode,-1);
+	for (size_t k=0;k<server.size();k++)
+		slots[server[k]]=server_slot[k];
+	finish();
+	return true;
+}
+
+///////////////////////////////
+// topologies built in memory
+
+void Topology::create(int n_node)
+{
+	close();
+	nNode=n_node;
+	slots.assign(nNode,-1);
+}
+
+void Topology::reserve(int n_link)
+{
+	froms.reserve(n_link);	tos.reserve(n_link);
+	costs.reserve(n_link);	bandwidths.reserve(n_link);
+}
+
+void Topology::finish()
+{
+	nLink=(int)froms.size();
+	buildAdjacency();
+	pointToVectors();
+}
+
+// CSR of the links, by counting the degrees
+void Topology::buildAdjacency()
+{
+	firsts.assign(nNode+1,0);
+	for (int a=0;a<nLink;a++)
+	{	firsts[froms[a]+1]++;
+		firsts[tos[a]+1]++;
+	}
+	for (int v=0;v<nNode;v++)
+		firsts[v+1]+=firsts[v];
+	vector<int> pos(firsts.begin(),firsts.end()-1);
+	adjs.resize(2*nLink);
+	for (int a=0;a<nLink;a++)
+	{	adjs[pos[froms[a]]++]=a;
+		adjs[pos[tos[a]]++]=nLink+a;
+	}
+}
+
+template <class Type>
+static const Type* pointer(const vector<Type>& x)
+{
+	return x.empty()?0:&x[0];
+}
+
+void Topology::pointToVectors()
+{
+	slot=pointer(slots);	first=pointer(firsts);	adj=pointer(adjs);
+	from=pointer(froms);	to=pointer(tos);
+	cost=pointer(costs);	bandwidth=pointer(bandwidths);
+}
+
+///////////////////////////////
+// binary files
+
+const size_t topologyHeader=16;	// magic, version, nNode, nLink
+
+static size_t topologySize(int nNode,int nLink)
+{
+	return topologyHeader+4*((size_t)nNode+(nNode+1)+2*(size_t)nLink+4*(size_t)nLink);
+}
+
+bool Topology::mapBinary(const char* filename)
+{
+	close();
+#ifdef _WIN32
+	HANDLE f=CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ,0,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,0);
+	if (f==INVALID_HANDLE_VALUE)
+	{	cerr << "Cannot open " << filename << " for input\n";
+		return false;
+	}
+	LARGE_INTEGER size;
+	GetFileSizeEx(f,&size);
+	HANDLE m=CreateFileMapping(f,0,PAGE_READONLY,0,0,0);
+	void* v=m?MapViewOfFile(m,FILE_MAP_READ,0,0,0):0;
+	if (!v)
+	{	cerr << "Cannot map " << filename << "\n";
+		if (m)
+			CloseHandle(m);
+		CloseHandle(f);
+		return false;
+	}
+	file=f;	mapping=m;
+	view=v;	viewSize=(size_t)size.QuadPart;
+#else
+	int fd=open(filename,O_RDONLY);
+	if (fd<0)
+	{	cerr << "Cannot open " << filename << " for input\n";
+		return false;
+	}
+	struct stat st;
+	void* v=MAP_FAILED;
+	if (fstat(fd,&st)==0&&st.st_size>0)
+		v=mmap(0,(size_t)st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+	::close(fd);
+	if (v==MAP_FAILED)
+	{	cerr << "Cannot map " << filename << "\n";
+		return false;
+	}
+	view=v;	viewSize=(size_t)st.st_size;
+#endif
+	const char* base=(const char*)view;
+	unsigned int version=0;
+	if (viewSize>=topologyHeader)
+		memcpy(&version,base+4,4);
+	if (viewSize<topologyHeader||memcmp(base,topologyMagic,4)!=0||version!=topologyVersion)
+	{	cerr << filename << " is not a topology of version " << topologyVersion << "\n";
+		close();
+		return false;
+	}
+	int n_node,n_link;
+	memcpy(&n_node,base+8,4);
+	memcpy(&n_link,base+12,4);
+	if (n_node<0||n_link<0||viewSize<topologySize(n_node,n_link))
+	{	cerr << filename << " is truncated\n";
+		close();
+		return false;
+	}
+	nNode=n_node;	nLink=n_link;
+	const int* p=(const int*)(base+topologyHeader);
+	slot=p;			p+=nNode;
+	first=p;		p+=nNode+1;
+	adj=p;			p+=2*nLink;
+	from=p;			p+=nLink;
+	to=p;			p+=nLink;
+	cost=(const float*)p;		p+=nLink;
+	bandwidth=(const float*)p;
+	if (!valid())
+	{	cerr << filename << " has a bad adjacency\n";
+		close();
+		return false;
+	}
+	return true;
+}
+
+// the indices of a mapped file, which the engines use without checks
+bool Topology::valid() const
+{
+	if (first[0]!=0||first[nNode]!=2*nLink)
+		return false;
+	for (int v=0;v<nNode;v++)
+		if (first[v]>first[v+1])
+			return false;
+	for (int a=0;a<nLink;a++)
+		if (from[a]<0||from[a]>=nNode||to[a]<0||to[a]>=nNode)
+			return false;
+	// every end of every link once, at its node: the degrees count the links of the nodes
+	vector<char> seen(2*(size_t)nLink,0);
+	for (int v=0;v<nNode;v++)
+		for (int k=first[v];k<first[v+1];k++)
+		{	int a=adj[k];
+			if (a<0||a>=2*nLink||seen[a]||(a<nLink?from[a]:to[a-nLink])!=v)
+				return false;
+			seen[a]=1;
+		}
+	return true;
+}
+
+bool Topology::save(const char* filename) const
+{
+	ofstream out(filename,ios::binary);
+	if (!out)
+	{	cerr << "Cannot open " << filename << " for output\n";
+		return false;
+	}
+	out.write(topologyMagic,4);
+	out.write((const char*)&topologyVersion,4);
+	out.write((const char*)&nNode,4);
+	out.write((const char*)&nLink,4);
+	out.write((const char*)slot,4*(size_t)nNode);
+	out.write((const char*)first,4*((size_t)nNode+1));
+	out.write((const char*)adj,4*2*(size_t)nLink);
+	out.write((const char*)from,4*(size_t)nLink);
+	out.write((const char*)to,4*(size_t)nLink);
+	out.write((const char*)cost,4*(size_t)nLink);
+	out.write((const char*)bandwidth,4*(size_t)nLink);
+	if (!out)
+	{	cerr << "Cannot write " << filename << "\n";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,72 @@
+#ifndef topology_H
+#define topology_H
+#include <vector>
+#include <cstddef>
+using namespace std;
+///////////////////////////////
+// topology files of Graph::drawGragh, in two formats told apart by the magic.
+//
+// text: one line per server "v slot" and one line per link "s d cost bandwidth", the nodes are
+// numbered from 1 and the links get their addresses in the order of the lines. the file is read
+// at once and parsed in place.
+//
+// binary: "VDCG", uint32 version, int32 nNode, int32 nLink, then
+//	int32 slot[nNode], int32 first[nNode+1], int32 adj[2*nLink],
+//	int32 from[nLink], int32 to[nLink], float cost[nLink], float bandwidth[nLink]
+// the nodes are numbered from 0, slot is -1 for a switch. adj[first[v]..first[v+1]) are the
+// links of node v in the order of the links, a for the link a from v, nLink+a for the link a to v.
+// the file is memory mapped and the arrays point into it, nothing is copied; the indices are
+// checked once, a file whose nodes or links are out of range is rejected. save() converts a
+// text file, the numbers are stored in the byte order of the machine.
+//
+// a topology can also be built in memory (see generators.h): create the nodes, set the slots
+// of the servers, add the links, then finish.
+
+const char topologyMagic[4]={'V','D','C','G'};	// not the traceMagic of trace.h
+const unsigned int topologyVersion=1;
+
+class Topology
+{
+public:
+	int nNode,nLink;
+	const int *slot,*first,*adj;
+	const int *from,*to;
+	const float *cost,*bandwidth;
+
+	Topology();
+	~Topology();
+	bool load(const char* filename);	// binary or text, the other binary files are rejected
+	bool loadText(const char* filename);
+	bool mapBinary(const char* filename);	// binary
+	bool save(const char* filename) const;
+	void close();
+	int degree(int v) const {return first[v+1]-first[v];}
+
+	void create(int n_node);	// n_node switches without links
+	void setServer(int v,int slot_v){slots[v]=slot_v;}
+	void reserve(int n_link);
+	void addLink(int s,int d,float c,float bw)
+	{
+		froms.push_back(s);	tos.push_back(d);
+		costs.push_back(c);	bandwidths.push_back(bw);
+	}
+	void finish();				// the adjacency of the links
+
+private:
+	// the arrays of a text file
+	vector<int> slots,firsts,adjs,froms,tos;
+	vector<float> costs,bandwidths;
+	// the mapping of a binary file
+	void* view;
+	size_t viewSize;
+#ifdef _WIN32
+	void *file,*mapping;
+#endif
+	void buildAdjacency();
+	bool valid() const;
+	void pointToVectors();
+	Topology(const Topology&);
+	const Topology& operator=(const Topology&);
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include "trace.h"
+using namespace std;
+
+TraceReader::TraceReader(int bufSize)
+	:buf(bufSize),begin(0),end(0),eof(true),lastArrival(0),n_read(0),n_error(0),line(0)
+{
+}
+
+bool TraceReader::open(const char* filename)
+{
+	close();
+	in.open(filename,ios::in|ios::binary);
+	if (!in) {
+		cerr << "Cannot open " << filename << " for input\n";
+		return false;
+	}
+	this->filename=filename;
+	eof=false;
+	format=JSONL;
+	if (fill(8)&&memcmp(&buf[begin],traceMagic,4)==0)
+	{
+		unsigned int version;
+		memcpy(&version,&buf[begin+4],4);
+		if (version!=traceVersion) {
+			cerr << filename << ": unsupported trace version " << version << "\n";
+			close();
+			return false;
+		}
+		format=BINARY;
+		begin+=8;
+	}
+	// the other binary files of the simulator, e.g. a topology
+	else if (end-begin>=4&&memcmp(&buf[begin],traceMagic,3)==0)
+	{
+		cerr << filename << " is not a request trace\n";
+		close();
+		return false;
+	}
+	return true;
+}
+
+void TraceReader::close()
+{
+	if (in.is_open())
+		in.close();
+	in.clear();
+	begin=end=0;
+	eof=true;
+	lastArrival=0;
+	n_read=n_error=line=0;
+}
+
+bool TraceReader::fill(int n)
+{
+	if (end-begin>=n)
+		return true;
+	// move the unread bytes to the front and read behind them
+	if (begin>0)
+	{
+		memmove(&buf[0],&buf[begin],end-begin);
+		end-=begin;
+		begin=0;
+	}
+	if (n>(int)buf.size())
+		return false;
+	while (!eof&&end<n)
+	{
+		in.read(&buf[end],buf.size()-end);
+		int got=(int)in.gcount();
+		end+=got;
+		if (got==0)
+			eof=true;
+	}
+	return end-begin>=n;
+}
+
+bool TraceReader::next(Cluster& req)
+{
+	double arrival=0;
+	for (;;)
+	{
+		bool ok=(format==JSONL)?nextJSONL(arrival,req):nextBinary(arrival,req);
+		if (!ok)
+			return false;
+		if (n_read==0)		// the times are relative to the first request
+			lastArrival=arrival;
+		if (arrival>=lastArrival)
+			break;
+		n_error++;
+		cerr << "request " << n_read+n_error << " of the trace arrives " << lastArrival-arrival
+			<< " before the previous one, skipped\n";
+	}
+	req.Arrivaltime=(float)(arrival-lastArrival);
+	lastArrival=arrival;
+	n_read++;
+	return true;
+}
+
+bool TraceReader::resume(int n_read)
+{
+	string name=filename;
+	if (!open(name.c_str()))
+		return false;
+	return RequestSource::resume(n_read);
+}
+
+static const char* skipSpace(const char* p,const char* e)
+{
+	while (p<e&&(*p==' '||*p=='\t'||*p=='\r'||*p=='\n'))
+		p++;
+	return p;
+}
+bool TraceReader::nextJSONL(double& arrival,Cluster& req)
+{
+	for (;;)
+	{
+		// a complete line in the buffer, the last line may end without a newline
+		int scanned=0;
+		const char* nl=0;
+		while (!(nl=(const char*)memchr(&buf[0]+begin+scanned,'\n',end-begin-scanned))&&!eof)
+		{
+			scanned=end-begin;
+			if (scanned>=(int)buf.size())
+			{	cerr << "trace line " << line+1 << " is longer than " << buf.size() << " bytes\n";
+				return false;
+			}
+			fill(scanned+1);
+		}
+		if (begin>=end)
+			return false;
+		const char* s=&buf[0]+begin;
+		const char* e=nl?nl:&buf[0]+end;
+		begin=(int)(e-&buf[0])+(nl?1:0);
+		line++;
+		s=skipSpace(s,e);
+		if (s==e)	// blank line
+			continue;
+		if (parseJSONL(s,e,arrival,req))
+			return true;
+		n_error++;
+		cerr << "trace line " << line << " is not a valid request, skipped\n";
+	}
+}
+
+// the flat JSON objects of the trace: numbers and arrays of numbers, other values are skipped
+static const char* parseNumber(const char* p,const char* e,double& x)
+{
+	char tmp[64];
+	int n=0;
+	while (p+n<e&&n<63&&strchr("+-.0123456789eE",p[n]))
+	{	tmp[n]=p[n];
+		n++;
+	}
+	tmp[n]=0;
+	char* stop;
+	x=strtod(tmp,&stop);
+	return stop==tmp?0:p+(stop-tmp);
+}
+static const char* skipValue(const char* p,const char* e)
+{
+	int depth=0;
+	bool quoted=false;
+	for (;p<e;p++)
+	{
+		if (quoted)
+		{	if (*p=='\\')
+				p++;
+			else if (*p=='"')
+				quoted=false;
+			continue;
+		}
+		if (*p=='"')	quoted=true;
+		else if (*p=='['||*p=='{')	depth++;
+		else if (*p==']'||*p=='}')
+		{	if (depth==0)
+				return p;
+			depth--;
+		}
+		else if (*p==','&&depth==0)
+			return p;
+	}
+	return p;
+}
+
+bool TraceReader::parseJSONL(const char* p,const char* e,double& arrival,Cluster& req)
+{
+	bool has_arrival=false,has_hold=false;
+	int N=-1;
+	req.B.clear();
+	req.Group.clear();
+	p=skipSpace(p,e);
+	if (p>=e||*p!='{')
+		return false;
+	p++;
+	for (;;)
+	{
+		p=skipSpace(p,e);
+		if (p<e&&*p=='}')
+			break;
+		if (p>=e||*p!='"')
+			return false;
+		const char* k=++p;
+		while (p<e&&*p!='"')
+			p++;
+		string key(k,p);
+		p=skipSpace(p+1,e);
+		if (p>=e||*p!=':')
+			return false;
+		p=skipSpace(p+1,e);
+		double x;
+		if (key=="arrival"||key=="hold"||key=="N")
+		{
+			if (!(p=parseNumber(p,e,x)))
+				return false;
+			if (key=="arrival")	{arrival=x;has_arrival=true;}
+			else if (key=="hold")	{req.Holdtime=(float)x;has_hold=true;}
+			else	N=(int)x;
+		}
+		else if (key=="B"||key=="group")
+		{
+			if (*p!='[')
+				return false;
+			p=skipSpace(p+1,e);
+			while (p<e&&*p!=']')
+			{
+				if (!(p=parseNumber(p,e,x)))
+					return false;
+				if (key=="B")	req.B.push_back((float)x);
+				else	req.Group.push_back((int)x);
+				p=skipSpace(p,e);
+				if (p<e&&*p==',')
+					p=skipSpace(p+1,e);
+			}
+			if (p>=e)
+				return false;
+			p++;
+		}
+		else
+			p=skipValue(p,e);
+		p=skipSpace(p,e);
+		if (p<e&&*p==',')
+			p++;
+		else if (p<e&&*p=='}')
+			break;
+		else
+			return false;
+	}
+	req.N=(int)req.B.size();
+	return has_arrival&&has_hold&&req.N>0&&(N<0||N==req.N)
+		&&(req.Group.empty()||(int)req.Group.size()==req.N);
+}
+
+bool TraceReader::nextBinary(double& arrival,Cluster& req)
+{
+	const int head=sizeof(double)+sizeof(float)+sizeof(int);
+	if (!fill(head))
+		return false;
+	int N,nGroup=-1;
+	memcpy(&arrival,&buf[begin],sizeof(double));
+	memcpy(&req.Holdtime,&buf[begin+sizeof(double)],sizeof(float));
+	memcpy(&N,&buf[begin+sizeof(double)+sizeof(float)],sizeof(int));
+	int size=head+N*(int)sizeof(float)+(int)sizeof(int);
+	if (N>0&&fill(size))
+	{	memcpy(&nGroup,&buf[begin+size-sizeof(int)],sizeof(int));
+		size+=max(nGroup,0)*(int)sizeof(int);
+	}
+	if (N<=0||(nGroup!=0&&nGroup!=N)||!fill(size))
+	{	cerr << "truncated or invalid request " << n_read+1 << " in the binary trace\n";
+		n_error++;
+		return false;
+	}
+	req.N=N;
+	req.B.resize(N);
+	memcpy(&req.B[0],&buf[begin+head],N*sizeof(float));
+	req.Group.resize(nGroup);
+	if (nGroup>0)
+		memcpy(&req.Group[0],&buf[begin+head+N*sizeof(float)+sizeof(int)],nGroup*sizeof(int));
+	begin+=size;
+	return true;
+}
+
+int writeTrace(RequestSource& source,const char* filename,int numOfreq)
+{
+	ofstream out(filename,ios::out|ios::binary);
+	if (!out) {
+		cerr << "Cannot open " << filename << " for output\n";
+		return 0;
+	}
+	out.write(traceMagic,4);
+	out.write((const char*)&traceVersion,sizeof(traceVersion));
+	Cluster req;
+	double arrival=0;
+	int n=0;
+	for (;(numOfreq<0||n<numOfreq)&&source.next(req);n++)
+	{
+		arrival+=req.Arrivaltime;
+		int nGroup=(int)req.Group.size();
+		out.write((const char*)&arrival,sizeof(double));
+		out.write((const char*)&req.Holdtime,sizeof(float));
+		out.write((const char*)&req.N,sizeof(int));
+		out.write((const char*)&req.B[0],req.N*sizeof(float));
+		out.write((const char*)&nGroup,sizeof(int));
+		if (nGroup>0)
+			out.write((const char*)&req.Group[0],nGroup*sizeof(int));
+	}
+	out.close();
+	return n;
+}
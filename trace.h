@@ -0,0 +1,91 @@
+#ifndef trace_H
+#define trace_H
+#include <vector>
+#include <fstream>
+#include <string>
+#include "elements.h"
+#include "frandom.h"
+using namespace std;
+///////////////////////////////
+// sources of the VDC requests fed to ProcessRequest
+
+class RequestSource
+{
+public:
+	virtual ~RequestSource(){}
+	// the next request, Arrivaltime is the time since the previous one; false at the end
+	virtual bool next(Cluster& req)=0;
+	// continue after the first n_read requests of a checkpointed run, false if there are fewer
+	virtual bool resume(int n_read)
+	{
+		Cluster req;
+		for (int k=0;k<n_read;k++)
+			if (!next(req))
+				return false;
+		return true;
+	}
+};
+
+// synthetic requests of Cluster::random, the load is relative to the given network
+class RandomRequests:public RequestSource
+{
+public:
+	RandomRequests(Random& rng,float load,int n_server=nServer,int max_slot=maxSlot,int n_port=n_server_port)
+		:rng(rng),load(load),n_server(n_server),max_slot(max_slot),n_port(n_port){}
+	bool next(Cluster& req){req.random(rng,load,n_server,max_slot,n_port);req.Group.clear();return true;}
+	bool resume(int){return true;}	// the random stream is restored by the checkpoint
+private:
+	Random& rng;
+	float load;
+	int n_server,max_slot,n_port;
+};
+
+// streaming reader of a request trace, the file is read through a bounded buffer.
+//
+// JSONL: one request per line, unknown keys are ignored, e.g.
+//	{"arrival": 12.5, "hold": 300, "B": [100, 200, 200], "group": [0, 1, 1]}
+// arrival is the arrival time, N is optional and must match the size of B,
+// group is optional (the group of each VM). the times are relative: the first request arrives at
+// time 0 of the run, so that the timestamps of a trace, e.g. seconds since the epoch, are
+// neither rounded to a float nor counted in the duration of the run.
+// the arrivals must not decrease, a request that arrives before the previous one is skipped and
+// counted as an error like an invalid line.
+//
+// binary: "VDCT", uint32 version, then per request
+//	double arrival, float hold, int32 N, float B[N], int32 nGroup (0 or N), int32 group[nGroup]
+class TraceReader:public RequestSource
+{
+public:
+	enum Format{JSONL,BINARY};
+	explicit TraceReader(int bufSize=1<<20);
+	// the format is detected from the magic of the file, the other binary files are rejected
+	bool open(const char* filename);
+	void close();
+	bool next(Cluster& req);
+	bool resume(int n_read);	// from the start of the file
+	int numOfRequests() const {return n_read;}
+	int numOfErrors() const {return n_error;}
+
+private:
+	ifstream in;
+	string filename;
+	Format format;
+	vector<char> buf;
+	int begin,end;		// the unread bytes buf[begin,end)
+	bool eof;
+	double lastArrival;
+	int n_read,n_error,line;
+
+	bool fill(int n);	// at least n unread bytes, false if the file ends before
+	bool nextJSONL(double& arrival,Cluster& req);
+	bool nextBinary(double& arrival,Cluster& req);
+	bool parseJSONL(const char* s,const char* e,double& arrival,Cluster& req);
+};
+
+const char traceMagic[4]={'V','D','C','T'};
+const unsigned int traceVersion=1;
+
+// write numOfreq requests of a source as a binary trace (all of them if numOfreq<0), e.g. to convert a JSONL trace
+int writeTrace(RequestSource& source,const char* filename,int numOfreq=-1);
+
+#endif
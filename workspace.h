@@ -0,0 +1,107 @@
+#ifndef workspace_H
+#define workspace_H
+#include <vector>
+#include <cstring>
+#include "parameter.h"
+#include "arena.h"
+#include "mincostflow.h"
+using namespace std;
+///////////////////////////////
+// scratch memory of the placement algorithms of an engine, allocated once and reused by every
+// request, instead of the [nServer][nServer] and [Ne] arrays on the stack of each call.
+//
+// a function that needs scratch memory opens a WorkFrame: the frames of nested calls, e.g.
+// Pertubation -> CongestDetect, get different buffers, the buffers of a depth are allocated
+// by its first frame. the per-server arrays are zeroed when a frame opens, the per-edge
+// flags are cleared in O(1) by a generation counter. the containers of a request, whose sizes
+// depend on the request, are drawn from the arena (see arena.h).
+
+// flags of the edges of Topo, clear() is O(1)
+template <class Topo>
+class EdgeMarksT
+{
+public:
+	EdgeMarksT():generation(1){memset(stamp,0,sizeof(stamp));}
+	void clear()
+	{
+		if (++generation==0)	// wrapped around: the old stamps could match again
+		{	memset(stamp,0,sizeof(stamp));
+			generation=1;
+		}
+	}
+	bool operator[](int e) const {return stamp[e]==generation;}
+	void set(int e){stamp[e]=generation;}
+	void unset(int e){stamp[e]=0;}
+private:
+	unsigned stamp[Topo::Ne];
+	unsigned generation;
+};
+typedef EdgeMarksT<CompiledTopology> EdgeMarks;
+
+template <class Topo>
+class WorkspaceT
+{
+public:
+	enum{nServer=Topo::nServer,Ne=Topo::Ne};
+	struct Frame
+	{
+		float sum_capacity[nServer][nServer];	// set by QuickFail
+		float hostBw[nServer];					// bandwidths of the servers assigned to the current VDC
+		float res_port_B[nServer];				// quick fail: residual bandwidths of the server ports
+		float TS[nServer],TD[nServer];			// traffic from and to the servers
+		int rank[Ne];			// edge ranking of CongestDetect
+		float load[Ne];
+		EdgeMarksT<Topo> calculated;	// edges whose max traffic is known
+	};
+	WorkspaceT():heap(Topo::Nv),depth(0){}
+	~WorkspaceT()
+	{
+		for (size_t k=0;k<frames.size();k++)
+			delete frames[k];
+	}
+	Frame& enter()
+	{
+		if (depth==frames.size())
+			frames.push_back(new Frame);
+		Frame& f=*frames[depth++];
+		memset(f.hostBw,0,sizeof(f.hostBw));
+		memset(f.res_port_B,0,sizeof(f.res_port_B));
+		memset(f.TS,0,sizeof(f.TS));
+		memset(f.TD,0,sizeof(f.TD));
+		return f;
+	}
+	void leave(){depth--;}
+	Arena arena;		// assignments and tabu lists of the placement
+	MinCostFlow flow;	// the flow of maxTrafficFlow, its arcs keep their memory
+	BinaryHeap<Comparable> heap;	// the heap of Dijkstra
+	// per-server, per-edge bounds of CalcMaxLinkUt, zeroed
+	float (*linkBounds(int k))[Ne/2]
+	{
+		vector<float>& b=bounds[k];
+		b.assign((size_t)nServer*(Ne/2),0);
+		return (float (*)[Ne/2])&b[0];
+	}
+
+private:
+	vector<Frame*> frames;
+	size_t depth;		// frames in use
+	vector<float> bounds[2];
+	WorkspaceT(const WorkspaceT&);
+	const WorkspaceT& operator=(const WorkspaceT&);
+};
+typedef WorkspaceT<CompiledTopology> Workspace;
+
+// the frame of a call, released on return
+template <class Topo>
+class WorkFrameT
+{
+public:
+	typename WorkspaceT<Topo>::Frame& f;
+	explicit WorkFrameT(WorkspaceT<Topo>& w):f(w.enter()),w(w){}
+	~WorkFrameT(){w.leave();}
+private:
+	WorkspaceT<Topo>& w;
+};
+typedef WorkFrameT<CompiledTopology> WorkFrame;
+
+#endif